@@ -0,0 +1,232 @@
+#ifndef ORDER_ID_MAP_H
+#define ORDER_ID_MAP_H
+
+#include <memory>
+#include <bit>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+
+#include "common/types.h"
+
+namespace hft
+{
+    // Flat Robin Hood hash table keyed by 64-bit order ids.
+    // Probe distances live in their own byte array (0 = empty, d = d-1 slots
+    // past home), separate from the key/value slots, so a probe walks one dense
+    // metadata line before it touches any slot. Deletion uses backward shift,
+    // so there are no tombstones and probe lengths do not degrade under
+    // insert/erase churn. The table is sized at construction and only grows if
+    // the reserved capacity is exceeded.
+    template <typename Value>
+        requires std::is_trivially_copyable_v<Value> && std::is_default_constructible_v<Value>
+    class OrderIdMap
+    {
+        struct Slot
+        {
+            OrderId key;
+#ifdef _MSC_VER
+            Value value [[msvc::no_unique_address]];
+#else
+            Value value [[no_unique_address]];
+#endif
+        };
+
+    public:
+        explicit OrderIdMap(size_t expected_size = 1024)
+        {
+            Allocate(CapacityFor(expected_size));
+        }
+
+        OrderIdMap(const OrderIdMap &) = delete;
+        OrderIdMap &operator=(const OrderIdMap &) = delete;
+        OrderIdMap(OrderIdMap &&) noexcept = default;
+        OrderIdMap &operator=(OrderIdMap &&) noexcept = default;
+
+        [[nodiscard]] Value *Find(OrderId key) noexcept
+        {
+            size_t idx = Home(key);
+            for (uint8_t dist = 1; ; ++dist, idx = (idx + 1) & m_mask)
+            {
+                const uint8_t meta = m_meta[idx];
+                if (meta < dist) { return nullptr; }
+                if (meta == dist && m_slots[idx].key == key) { return &m_slots[idx].value; }
+            }
+        }
+
+        [[nodiscard]] const Value *Find(OrderId key) const noexcept
+        {
+            return const_cast<OrderIdMap *>(this)->Find(key);
+        }
+
+        [[nodiscard]] bool Contains(OrderId key) const noexcept { return Find(key) != nullptr; }
+
+        Value &InsertOrAssign(OrderId key, const Value &value)
+        {
+            if ((m_size + 1) * MaxLoadDen > (m_mask + 1) * MaxLoadNum)
+            {
+                Rehash((m_mask + 1) * 2);
+            }
+
+            Slot pending{ key, value };
+            Value *placed = nullptr;
+            size_t idx = Home(key);
+
+            for (uint8_t dist = 1; ; ++dist, idx = (idx + 1) & m_mask)
+            {
+                if (dist == MaxDistance)
+                {
+                    // Pathological clustering, give the table more room and
+                    // retry whichever entry is still in hand.
+                    Rehash((m_mask + 1) * 2);
+                    InsertOrAssign(pending.key, pending.value);
+                    return *Find(key);
+                }
+
+                uint8_t &meta = m_meta[idx];
+                if (meta == 0)
+                {
+                    meta = dist;
+                    m_slots[idx] = pending;
+                    ++m_size;
+                    return placed ? *placed : m_slots[idx].value;
+                }
+
+                if (!placed && meta == dist && m_slots[idx].key == key)
+                {
+                    m_slots[idx].value = value;
+                    return m_slots[idx].value;
+                }
+
+                if (meta < dist)
+                {
+                    // Rich entry gives its slot to the poorer one we carry.
+                    std::swap(pending, m_slots[idx]);
+                    std::swap(dist, meta);
+                    if (!placed) { placed = &m_slots[idx].value; }
+                }
+            }
+        }
+
+        bool Erase(OrderId key) noexcept
+        {
+            size_t idx = Home(key);
+            for (uint8_t dist = 1; ; ++dist, idx = (idx + 1) & m_mask)
+            {
+                const uint8_t meta = m_meta[idx];
+                if (meta < dist) { return false; }
+                if (meta == dist && m_slots[idx].key == key) { break; }
+            }
+
+            size_t next = (idx + 1) & m_mask;
+            while (m_meta[next] > 1)
+            {
+                m_meta[idx] = m_meta[next] - 1;
+                m_slots[idx] = m_slots[next];
+                idx = next;
+                next = (next + 1) & m_mask;
+            }
+
+            m_meta[idx] = 0;
+            --m_size;
+            return true;
+        }
+
+        void Clear() noexcept
+        {
+            std::fill_n(m_meta.get(), m_mask + 1, uint8_t{ 0 });
+            m_size = 0;
+        }
+
+        void Reserve(size_t expected_size)
+        {
+            size_t capacity = CapacityFor(expected_size);
+            if (capacity > m_mask + 1) { Rehash(capacity); }
+        }
+
+        [[nodiscard]] size_t Size() const noexcept { return m_size; }
+        [[nodiscard]] bool Empty() const noexcept { return m_size == 0; }
+        [[nodiscard]] size_t Capacity() const noexcept { return m_mask + 1; }
+
+    private:
+        // Grow past 3/4 load; Robin Hood keeps probes short well beyond that,
+        // but the headroom keeps distances inside one metadata byte.
+        static constexpr size_t MaxLoadNum = 3;
+        static constexpr size_t MaxLoadDen = 4;
+        static constexpr uint8_t MaxDistance = 255;
+
+        std::unique_ptr<uint8_t[]> m_meta;
+        std::unique_ptr<Slot[]> m_slots;
+        size_t m_mask{ 0 };
+        size_t m_size{ 0 };
+        uint32_t m_shift{ 0 };
+
+        static size_t CapacityFor(size_t expected_size)
+        {
+            size_t min_slots = expected_size * MaxLoadDen / MaxLoadNum + 1;
+            return std::bit_ceil(std::max<size_t>(min_slots, 16));
+        }
+
+        size_t Home(OrderId key) const noexcept
+        {
+            // Fibonacci hashing: ids are mostly sequential, the multiply spreads
+            // them and the top bits index the table.
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+        }
+
+        void Allocate(size_t capacity)
+        {
+            m_meta = std::make_unique<uint8_t[]>(capacity);
+            m_slots = std::make_unique_for_overwrite<Slot[]>(capacity);
+            m_mask = capacity - 1;
+            m_shift = 64 - std::countr_zero(capacity);
+            m_size = 0;
+        }
+
+        void Rehash(size_t capacity)
+        {
+            auto old_meta = std::move(m_meta);
+            auto old_slots = std::move(m_slots);
+            const size_t old_capacity = m_mask + 1;
+
+            Allocate(capacity);
+            for (size_t i = 0; i < old_capacity; ++i)
+            {
+                if (old_meta[i] != 0)
+                {
+                    InsertOrAssign(old_slots[i].key, old_slots[i].value);
+                }
+            }
+        }
+    };
+
+    // Set flavour used where only membership matters.
+    class OrderIdSet
+    {
+        struct NoValue { };
+
+    public:
+        explicit OrderIdSet(size_t expected_size = 1024)
+            : m_map(expected_size)
+        { }
+
+        bool Insert(OrderId key)
+        {
+            if (m_map.Contains(key)) { return false; }
+            m_map.InsertOrAssign(key, NoValue{ });
+            return true;
+        }
+
+        bool Erase(OrderId key) noexcept { return m_map.Erase(key); }
+        [[nodiscard]] bool Contains(OrderId key) const noexcept { return m_map.Contains(key); }
+        [[nodiscard]] size_t Size() const noexcept { return m_map.Size(); }
+        [[nodiscard]] bool Empty() const noexcept { return m_map.Empty(); }
+
+    private:
+        OrderIdMap<NoValue> m_map;
+    };
+
+} // namespace hft
+
+#endif // ORDER_ID_MAP_H
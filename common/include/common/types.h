@@ -2,11 +2,33 @@
 #define TYPES_H
 
 #include <cstdint>
+#include <compare>
 
 using OrderId = uint64_t;
-using Price = double;
 using Quantity = uint32_t;
 
+// Prices are integer ticks from the wire to the book, so levels can be array
+// indexed and the matching loop compares integers. Convert to decimal only at
+// the logging/reporting edges with ToDecimal.
+struct PriceTicks
+{
+    int64_t value{ 0 };
+
+    constexpr auto operator<=>(const PriceTicks &) const = default;
+};
+
+using Price = PriceTicks;
+
+inline constexpr double DefaultTickSize = 0.01;
+
+constexpr PriceTicks operator+(PriceTicks price, int64_t ticks) { return PriceTicks{ price.value + ticks }; }
+constexpr PriceTicks operator-(PriceTicks price, int64_t ticks) { return PriceTicks{ price.value - ticks }; }
+
+constexpr double ToDecimal(PriceTicks price, double tick_size = DefaultTickSize)
+{
+    return static_cast<double>(price.value) * tick_size;
+}
+
 enum class Side
 {
     BUY,
@@ -72,6 +94,8 @@ public:
     Quantity RemainingQuantity() const { return (filled_qty >= quantity) ? 0u : (quantity - filled_qty); }
 };
 
+// MODIFY_ORDER reuses `order`: id names the resting order, price and
+// quantity carry the new values (quantity is the new total, fills included).
 struct OrderRequest
 {
     RequestType type;
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+#include "common/order_id_map.h"
+
+using namespace hft;
+
+TEST(OrderIdMap, InsertFindErase)
+{
+    OrderIdMap<uint32_t> map(16);
+
+    EXPECT_TRUE(map.Empty());
+    EXPECT_EQ(map.Find(42), nullptr);
+
+    map.InsertOrAssign(42, 7);
+    map.InsertOrAssign(43, 8);
+    ASSERT_NE(map.Find(42), nullptr);
+    EXPECT_EQ(*map.Find(42), 7u);
+    EXPECT_EQ(map.Size(), 2u);
+
+    map.InsertOrAssign(42, 9);
+    EXPECT_EQ(*map.Find(42), 9u);
+    EXPECT_EQ(map.Size(), 2u);
+
+    EXPECT_TRUE(map.Erase(42));
+    EXPECT_FALSE(map.Erase(42));
+    EXPECT_EQ(map.Find(42), nullptr);
+    EXPECT_EQ(*map.Find(43), 8u);
+    EXPECT_EQ(map.Size(), 1u);
+}
+
+TEST(OrderIdMap, ReservedCapacityDoesNotGrow)
+{
+    OrderIdMap<uint64_t> map(1000);
+    const size_t capacity = map.Capacity();
+
+    for (OrderId id = 1; id <= 1000; ++id)
+    {
+        map.InsertOrAssign(id, id * 2);
+    }
+
+    EXPECT_EQ(map.Capacity(), capacity);
+    for (OrderId id = 1; id <= 1000; ++id)
+    {
+        ASSERT_NE(map.Find(id), nullptr);
+        EXPECT_EQ(*map.Find(id), id * 2);
+    }
+}
+
+TEST(OrderIdMap, GrowsPastReservation)
+{
+    OrderIdMap<uint64_t> map(8);
+
+    for (OrderId id = 0; id < 10000; ++id)
+    {
+        map.InsertOrAssign(id, ~id);
+    }
+
+    EXPECT_EQ(map.Size(), 10000u);
+    EXPECT_GE(map.Capacity(), 10000u);
+    for (OrderId id = 0; id < 10000; ++id)
+    {
+        ASSERT_NE(map.Find(id), nullptr);
+        EXPECT_EQ(*map.Find(id), ~id);
+    }
+}
+
+TEST(OrderIdMap, RandomChurnMatchesUnorderedMap)
+{
+    OrderIdMap<uint32_t> map(256);
+    std::unordered_map<OrderId, uint32_t> reference;
+    std::mt19937_64 rng(1234);
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        OrderId id = rng() % 512;
+        if (rng() % 3 == 0)
+        {
+            EXPECT_EQ(map.Erase(id), reference.erase(id) == 1);
+        }
+        else
+        {
+            uint32_t value = static_cast<uint32_t>(rng());
+            map.InsertOrAssign(id, value);
+            reference[id] = value;
+        }
+    }
+
+    ASSERT_EQ(map.Size(), reference.size());
+    for (OrderId id = 0; id < 512; ++id)
+    {
+        auto it = reference.find(id);
+        const uint32_t *found = map.Find(id);
+        if (it == reference.end())
+        {
+            EXPECT_EQ(found, nullptr);
+        }
+        else
+        {
+            ASSERT_NE(found, nullptr);
+            EXPECT_EQ(*found, it->second);
+        }
+    }
+}
+
+TEST(OrderIdSet, Membership)
+{
+    OrderIdSet set;
+
+    EXPECT_TRUE(set.Insert(1000));
+    EXPECT_FALSE(set.Insert(1000));
+    EXPECT_TRUE(set.Contains(1000));
+    EXPECT_EQ(set.Size(), 1u);
+
+    EXPECT_TRUE(set.Erase(1000));
+    EXPECT_FALSE(set.Contains(1000));
+    EXPECT_TRUE(set.Empty());
+}
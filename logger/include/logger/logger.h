@@ -8,6 +8,9 @@
 #include <algorithm>
 #include <stdexcept>
 #include <array>
+#include <vector>
+#include <memory>
+#include <atomic>
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -17,7 +20,7 @@
 #undef ERROR
 
 #include "ring_buffer/ring_buffer.h"
-#include <mutex>
+#include "ring_buffer/huge_page_allocator.h"
 
 namespace hft
 {
@@ -63,59 +66,58 @@ namespace hft
             if (m_out.is_open()) m_out.flush();
         }
 
-        // TODO(vss): This logger uses SPSC ring buffer 
-        // but Log() can be called from multiple threads.
-        // This creates a race condition and UB. Need to:
-        // Replace SPSCRingBuffer with MPSCRingBuffer implementation
+        // Each calling thread gets its own SPSC channel on first use, so
+        // producers never contend with each other; after registration Log()
+        // is a copy plus one ring push. The flusher merges channels by
+        // timestamp_ns.
         bool Log(LogLevel level, const std::string &message)
         {
-            static std::mutex log_mutex;  // Sloppy fix until mpsc
-            std::lock_guard<std::mutex> lock(log_mutex);
-
             if (!m_running) return false;
 
-            LogEntry entry;
-            entry.timestamp_ns = Now();
-            entry.level = level;
-            entry.thread_id = static_cast<uint32_t>(GetCurrentThreadId());
-            
-            entry.payload_len = std::min(message.size(), sizeof(entry.payload) - 1);
-            memcpy(entry.payload, message.data(), entry.payload_len);
-            entry.payload[entry.payload_len] = '\0';
-            // NOTE(vss): We check for the min size, and overwrite the last char
-            // with the null-terminator, provides same effect without needing
-            // any extra checking or enforcing bounds/sizes.
+            Producer *producer = LocalProducer();
+            if (!producer)
+            {
+                m_unregistered_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
 
-            if (m_policy == OverflowPolicy::Drop)
+            // The entry is written straight into the claimed ring slot; a
+            // 320-byte LogEntry is never built on the stack or copied in.
+            LogEntry *entry = producer->buffer.TryClaim();
+            if (!entry)
             {
-                if (!m_buffer.TryPush(entry))
+                if (m_policy == OverflowPolicy::Drop)
                 {
-                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    producer->dropped.fetch_add(1, std::memory_order_relaxed);
                     return false;
                 }
-                
-                m_enqueued.fetch_add(1, std::memory_order_relaxed);
-                return true;
-                
-            }
-            else
-            {
+
                 // TODO(vss): Switch temporary implementation to a complete blocking policy.
-                for (;;)
+                while (!(entry = producer->buffer.TryClaim()))
                 {
-                    if (m_buffer.TryPush(entry))
-                    {
-                        m_enqueued.fetch_add(1);
-                        return true;
-                    }
                     std::this_thread::yield();
                 }
             }
+
+            entry->timestamp_ns = Now();
+            entry->level = level;
+            entry->thread_id = producer->thread_id;
+            
+            entry->payload_len = static_cast<uint16_t>(std::min(message.size(), sizeof(entry->payload) - 1));
+            memcpy(entry->payload, message.data(), entry->payload_len);
+            entry->payload[entry->payload_len] = '\0';
+            // NOTE(vss): We check for the min size, and overwrite the last char
+            // with the null-terminator, provides same effect without needing
+            // any extra checking or enforcing bounds/sizes.
+
+            producer->buffer.Commit();
+            producer->enqueued.fetch_add(1, std::memory_order_relaxed);
+            return true;
         }
 
         void Flush()
         {
-            while (!m_buffer.Empty())
+            while (!AllEmpty())
             {
                 std::this_thread::sleep_for(std::chrono::milliseconds(50));
             }
@@ -123,21 +125,123 @@ namespace hft
             m_out.flush();
         }
 
-        uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
-        uint64_t enqueued() const noexcept { return m_enqueued.load(std::memory_order_relaxed); }
+        uint64_t dropped() const noexcept
+        {
+            uint64_t total = m_unregistered_dropped.load(std::memory_order_relaxed);
+            ForEachProducer([&total](const Producer &p) { total += p.dropped.load(std::memory_order_relaxed); });
+            return total;
+        }
+
+        uint64_t enqueued() const noexcept
+        {
+            uint64_t total = 0;
+            ForEachProducer([&total](const Producer &p) { total += p.enqueued.load(std::memory_order_relaxed); });
+            return total;
+        }
+
+        size_t producers() const noexcept
+        {
+            return std::min(m_producer_count.load(std::memory_order_acquire), MaxProducers);
+        }
     
     private:
-        using RingBuffer = hft::SPSCRingBuffer<LogEntry, 1024>;
-        
-        RingBuffer m_buffer;
+        // Channels are prefaulted when a thread registers, not on its
+        // first burst of log lines.
+        using RingBuffer = hft::SPSCRingBuffer<LogEntry, 1024, hft::HugePageAllocator<LogEntry>>;
+        static constexpr size_t MaxProducers = 64;
+
+        struct Producer
+        {
+            RingBuffer buffer;
+            std::thread::id owner;
+            uint32_t thread_id{ 0 };
+            alignas(64) std::atomic<uint64_t> dropped{ 0 };
+            std::atomic<uint64_t> enqueued{ 0 };
+        };
+
+        // Published with release once fully built; slots past the count may
+        // still be null while a registration is in flight.
+        std::array<std::atomic<Producer *>, MaxProducers> m_producers{ };
+        std::array<std::unique_ptr<Producer>, MaxProducers> m_producer_storage;
+        std::atomic<size_t> m_producer_count{ 0 };
+        const uint64_t m_id{ NextLoggerId() };
+
         std::ofstream m_out;
         OverflowPolicy m_policy;
         std::thread m_log_flusher;
         std::atomic<bool> m_running{ true };
-        std::atomic<uint64_t> m_dropped{ 0 };
-        std::atomic<uint64_t> m_enqueued{ 0 };
+        std::atomic<uint64_t> m_unregistered_dropped{ 0 };
         double m_qpc_to_ns{ 0.0 };
 
+        static uint64_t NextLoggerId() noexcept
+        {
+            static std::atomic<uint64_t> next{ 1 };
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Cached per thread and keyed by logger id, so a logger created at a
+        // recycled address never sees a stale channel. A miss once every
+        // slot is taken is cached too: slots are never freed, so the thread
+        // drops without rescanning on every Log().
+        Producer *LocalProducer()
+        {
+            struct Cache
+            {
+                uint64_t logger_id{ 0 };
+                Producer *producer{ nullptr };
+            };
+            thread_local Cache cache;
+
+            if (cache.logger_id == m_id) { return cache.producer; }
+
+            Producer *producer = FindOrRegister();
+            cache = { m_id, producer };
+            return producer;
+        }
+
+        Producer *FindOrRegister()
+        {
+            // A recycled thread id means the previous owner has exited, so
+            // its channel can be adopted without breaking single-producer.
+            const auto self = std::this_thread::get_id();
+            for (size_t i = 0; i < producers(); ++i)
+            {
+                Producer *p = m_producers[i].load(std::memory_order_acquire);
+                if (p && p->owner == self) { return p; }
+            }
+
+            // Full already: skip the contended RMW.
+            if (m_producer_count.load(std::memory_order_relaxed) >= MaxProducers) { return nullptr; }
+
+            const size_t slot = m_producer_count.fetch_add(1, std::memory_order_acq_rel);
+            if (slot >= MaxProducers) { return nullptr; }
+
+            auto producer = std::make_unique<Producer>();
+            producer->owner = self;
+            producer->thread_id = static_cast<uint32_t>(GetCurrentThreadId());
+
+            Producer *raw = producer.get();
+            m_producer_storage[slot] = std::move(producer);
+            m_producers[slot].store(raw, std::memory_order_release);
+            return raw;
+        }
+
+        template <typename Fn>
+        void ForEachProducer(Fn &&fn) const
+        {
+            for (size_t i = 0; i < producers(); ++i)
+            {
+                if (const Producer *p = m_producers[i].load(std::memory_order_acquire)) { fn(*p); }
+            }
+        }
+
+        bool AllEmpty() const noexcept
+        {
+            bool empty = true;
+            ForEachProducer([&empty](const Producer &p) { empty = empty && p.buffer.Empty(); });
+            return empty;
+        }
+
         inline uint64_t Now() noexcept
         {
             LARGE_INTEGER qpc_now;
@@ -147,43 +251,70 @@ namespace hft
 
         void FlusherThreadFn()
         {
-            constexpr size_t BATCH_SIZE = 256;
+            constexpr size_t BATCH_SIZE = 1024;
+            constexpr size_t PER_PRODUCER = 128;
             constexpr auto IDLE_SLEEP = std::chrono::microseconds(50);
-            std::array<LogEntry, BATCH_SIZE> batch;
 
-            while (m_running.load(std::memory_order_acquire) || !m_buffer.Empty())
+            // Entries are formatted straight out of the rings: each pass
+            // takes a view per channel, merges pointers to them and releases
+            // the views once written.
+            struct View
             {
-                size_t count = 0;
-                
-                for (size_t i = 0; i < BATCH_SIZE; ++i)
+                Producer *producer;
+                size_t count;
+            };
+            std::vector<View> views;
+            std::vector<const LogEntry *> batch;
+            views.reserve(MaxProducers);
+            batch.reserve(BATCH_SIZE);
+            size_t start = 0;
+
+            while (m_running.load(std::memory_order_acquire) || !AllEmpty())
+            {
+                views.clear();
+                batch.clear();
+
+                // Round-robin across channels, rotating the starting one so a
+                // busy producer cannot keep the others waiting.
+                const size_t count = producers();
+                for (size_t n = 0; n < count && batch.size() < BATCH_SIZE; ++n)
                 {
-                    auto ptr = m_buffer.Peek();
-                    if (!ptr) { break; }
-                    
-                    batch[i] = *ptr;
-                    m_buffer.TryPop();
-                    ++count;
+                    Producer *p = m_producers[(start + n) % count].load(std::memory_order_acquire);
+                    if (!p) { continue; }
+
+                    auto entries = p->buffer.PeekN(std::min(PER_PRODUCER, BATCH_SIZE - batch.size()));
+                    if (entries.empty()) { continue; }
+
+                    views.push_back({ p, entries.size() });
+                    for (const auto &entry : entries) { batch.push_back(&entry); }
                 }
+                if (count) { start = (start + 1) % count; }
 
-                if (count == 0)
+                if (batch.empty())
                 {
                     std::this_thread::sleep_for(IDLE_SLEEP);
                     continue;
                 }
 
-                for (size_t i = 0; i < count; ++i)
+                // Each channel is already in time order; stable sort merges
+                // them without reordering entries from one thread.
+                std::stable_sort(batch.begin(), batch.end(),
+                                 [](const LogEntry *a, const LogEntry *b) { return a->timestamp_ns < b->timestamp_ns; });
+
+                for (const LogEntry *log : batch)
                 {
-                    auto &log = batch[i];
-                    const char *lvl = (log.level == LogLevel::DEBUG) ? "DEBUG" :
-                                      (log.level == LogLevel::INFO) ? "INFO" :
-                                      (log.level == LogLevel::WARNING) ? "WARNING" : "ERROR";
+                    const char *lvl = (log->level == LogLevel::DEBUG) ? "DEBUG" :
+                                      (log->level == LogLevel::INFO) ? "INFO" :
+                                      (log->level == LogLevel::WARNING) ? "WARNING" : "ERROR";
 
-                    m_out << log.timestamp_ns << ' ' 
-                          << log.thread_id << ' ' 
+                    m_out << log->timestamp_ns << ' ' 
+                          << log->thread_id << ' ' 
                           << lvl << ' ';
-                    m_out.write(log.payload, log.payload_len);
+                    m_out.write(log->payload, log->payload_len);
                     m_out << '\n';
                 }
+
+                for (const auto &view : views) { view.producer->buffer.Release(view.count); }
                 
                 m_out.flush();
             }
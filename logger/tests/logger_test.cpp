@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <regex>
 #include <fstream>
+#include <barrier>
 #include "logger/logger.h"
 
 using namespace hft;
@@ -214,4 +215,90 @@ TEST(LoggerTest, EmptyMessage)
     EXPECT_TRUE(payload.empty());
 
     std::remove(path.c_str());
-}
\ No newline at end of file
+}
+
+TEST(LoggerTest, ConcurrentProducersKeepPerThreadOrder)
+{
+    const std::string path = "tmp_multi.log";
+    std::remove(path.c_str());
+
+    constexpr int Threads = 4;
+    constexpr int PerThread = 5000;
+    {
+        Logger logger(path, OverflowPolicy::Block);
+
+        // Start together so no thread exits and has its id reused before
+        // the others register.
+        std::barrier started(Threads);
+        std::vector<std::thread> producers;
+        for (int t = 0; t < Threads; ++t)
+        {
+            producers.emplace_back([&logger, &started, t]()
+                {
+                    started.arrive_and_wait();
+                    for (int i = 0; i < PerThread; ++i)
+                    {
+                        logger.Log(LogLevel::INFO, "t" + std::to_string(t) + ":" + std::to_string(i));
+                    }
+                });
+        }
+        for (auto &producer : producers) { producer.join(); }
+
+        logger.Flush();
+        EXPECT_EQ(logger.producers(), static_cast<size_t>(Threads));
+        EXPECT_EQ(logger.enqueued(), static_cast<uint64_t>(Threads * PerThread));
+        EXPECT_EQ(logger.dropped(), 0u);
+    }
+
+    auto lines = ReadLines(path);
+    ASSERT_EQ(lines.size(), static_cast<size_t>(Threads * PerThread));
+
+    std::regex seq_re("t(\\d+):(\\d+)");
+    std::array<int, Threads> last;
+    last.fill(-1);
+    for (auto &line : lines)
+    {
+        std::smatch m;
+        ASSERT_TRUE(std::regex_search(line, m, seq_re));
+        int t = std::stoi(m[1].str());
+        int v = std::stoi(m[2].str());
+        EXPECT_EQ(v, last[t] + 1);
+        last[t] = v;
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(LoggerTest, ProducersBeyondLimitAreDropped)
+{
+    const std::string path = "tmp_limit.log";
+    std::remove(path.c_str());
+
+    // All alive at once, so no thread id is recycled and adopted.
+    constexpr int Threads = 70;
+    constexpr int Slots = 64;
+    {
+        Logger logger(path, OverflowPolicy::Block);
+
+        std::barrier logged(Threads);
+        std::vector<std::thread> producers;
+        for (int t = 0; t < Threads; ++t)
+        {
+            producers.emplace_back([&logger, &logged, t]()
+                {
+                    logger.Log(LogLevel::INFO, "first " + std::to_string(t));
+                    logger.Log(LogLevel::INFO, "second " + std::to_string(t));
+                    logged.arrive_and_wait();
+                });
+        }
+        for (auto &producer : producers) { producer.join(); }
+
+        logger.Flush();
+        EXPECT_EQ(logger.producers(), static_cast<size_t>(Slots));
+        EXPECT_EQ(logger.enqueued(), static_cast<uint64_t>(2 * Slots));
+        EXPECT_EQ(logger.dropped(), static_cast<uint64_t>(2 * (Threads - Slots)));
+    }
+
+    EXPECT_EQ(ReadLines(path).size(), static_cast<size_t>(2 * Slots));
+    std::remove(path.c_str());
+}
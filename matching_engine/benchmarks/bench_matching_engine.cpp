@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include "matching_engine/matching_engine.h"
+
+using namespace hft;
+
+constexpr int64_t Levels = 8;
+constexpr Price BaseAsk{ 10000 };
+
+static OrderRequest MakeRequest(Side side, Price price, Quantity qty, TimeInForce tif, OrderId id = 0)
+{
+    OrderRequest req{ };
+    req.type = RequestType::NEW_ORDER;
+    req.order.id = id;
+    req.order.side = side;
+    req.order.price = price;
+    req.order.quantity = qty;
+    req.order.type = OrderType::LIMIT;
+    req.order.tif = tif;
+    return req;
+}
+
+// Levels asks of `depth` one-lot orders each.
+template <typename Engine>
+static void FillAsks(Engine &engine, int64_t depth)
+{
+    OrderId id = 1;
+    for (int64_t level = 0; level < Levels; ++level)
+    {
+        for (int64_t i = 0; i < depth; ++i)
+        {
+            engine.ProcessOrderRequest(MakeRequest(Side::SELL, BaseAsk + level, 1, TimeInForce::GTC, id++));
+        }
+    }
+}
+
+// FOK that needs one lot more than the whole crossable range, so it is always
+// rejected after the liquidity check and the book is never consumed. Cost
+// should not move with the per-level queue depth.
+template <typename Book>
+static void BM_FOKRejectAcrossLevels(benchmark::State &state)
+{
+    const int64_t depth = state.range(0);
+    const SymbolReference symbol{ 0, static_cast<size_t>(Levels * depth), 1024 };
+    MatchingEngine<Book> engine(std::span<const SymbolReference>(&symbol, 1));
+    FillAsks(engine, depth);
+
+    const Quantity wanted = static_cast<Quantity>(Levels * depth + 1);
+    const auto fok = MakeRequest(Side::BUY, BaseAsk + (Levels - 1), wanted, TimeInForce::FOK);
+
+    for (auto _ : state)
+    {
+        engine.ProcessOrderRequest(fok);
+        benchmark::DoNotOptimize(engine.GetSink().Trades().size());
+    }
+}
+
+// Direct level-aggregate query over the same book.
+template <typename Book>
+static void BM_AvailableQuantity(benchmark::State &state)
+{
+    const int64_t depth = state.range(0);
+    const SymbolReference symbol{ 0, static_cast<size_t>(Levels * depth), 1024 };
+    MatchingEngine<Book> engine(std::span<const SymbolReference>(&symbol, 1));
+    FillAsks(engine, depth);
+
+    const Book &book = *engine.GetBook(0);
+    const Quantity wanted = static_cast<Quantity>(Levels * depth);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(book.AvailableQuantity(Side::SELL, BaseAsk + (Levels - 1), wanted));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_FOKRejectAcrossLevels, Orderbook)->RangeMultiplier(8)->Range(1, 4096);
+BENCHMARK_TEMPLATE(BM_FOKRejectAcrossLevels, LadderOrderbook)->RangeMultiplier(8)->Range(1, 4096);
+BENCHMARK_TEMPLATE(BM_AvailableQuantity, Orderbook)->RangeMultiplier(8)->Range(1, 4096);
+BENCHMARK_TEMPLATE(BM_AvailableQuantity, LadderOrderbook)->RangeMultiplier(8)->Range(1, 4096);
@@ -1,51 +1,88 @@
 #ifndef MATCHING_ENGINE_H
 #define MATCHING_ENGINE_H
 
-#include <memory>
 #include <vector>
 #include <chrono>
 #include <optional>
+#include <span>
+#include <concepts>
+#include <utility>
 
 #include "common/types.h"
 #include "orderbook/orderbook.h"
+#include "orderbook/ladder_orderbook.h"
+#include "orderbook/book_manager.h"
+#include "matching_engine/trade_sink.h"
 
 namespace hft
 {
+    // Book is any type exposing the Orderbook surface (Orderbook, LadderOrderbook).
+    // Requests are routed to a per-symbol book by OrderRequest::symbol_id.
+    // Fills go to Sink as they happen; see trade_sink.h.
+    template <typename Book = Orderbook, TradeSink Sink = VectorTradeSink>
     class MatchingEngine
     {
     public:
-        MatchingEngine() = default;
+        // Single-instrument engine trading symbol 0.
+        MatchingEngine() requires std::default_initializable<Sink>
+            : MatchingEngine(std::span<const SymbolReference>(&DefaultSymbol, 1))
+        { }
+
+        explicit MatchingEngine(std::span<const SymbolReference> symbols, Sink sink = Sink{ })
+            : m_books(symbols)
+            , m_sink(std::move(sink))
+        { }
 
         void ProcessOrderRequest(const OrderRequest &request)
         {
+            Book *book = m_books.Find(request.symbol_id);
+            if (!book)
+            {
+                ++m_unknown_symbol;
+                return;
+            }
+
             switch (request.type)
             {
                 case RequestType::NEW_ORDER:    
-                    ProcessNewOrder(request.order);
+                    ProcessNewOrder(*book, request.order);
                     break;
 
                 case RequestType::CANCEL_ORDER: 
-                    ProcessCancelOrder(request.order_id_to_cancel);
+                    ProcessCancelOrder(*book, request.order_id_to_cancel);
                     break;
 
                 case RequestType::MODIFY_ORDER: 
-                    // TODO
+                    ProcessModifyOrder(*book, request.order);
                     break;
             }
         }
 
-        std::vector<TradeEvent> GetAndClearTrades()
+        // Copies out and clears the buffered trades, leaving the sink's
+        // capacity in place. Convenience for tests; hot loops read
+        // GetSink().Trades() and call Clear() instead.
+        std::vector<TradeEvent> GetAndClearTrades() requires std::same_as<Sink, VectorTradeSink>
         {
-            std::vector<TradeEvent> trades;
-            trades.swap(m_trades);
-            return trades;
+            auto trades = m_sink.Trades();
+            std::vector<TradeEvent> out(trades.begin(), trades.end());
+            m_sink.Clear();
+            return out;
         }
 
+        Sink &GetSink() noexcept { return m_sink; }
+        const Sink &GetSink() const noexcept { return m_sink; }
+
+        Book *GetBook(uint32_t symbol_id) noexcept { return m_books.Find(symbol_id); }
+        uint64_t UnknownSymbolCount() const noexcept { return m_unknown_symbol; }
+
     private:
-        Orderbook m_orderbook;
+        static constexpr SymbolReference DefaultSymbol{ 0, 4096, 1024 };
+
+        BookManager<Book> m_books;
+        uint64_t m_unknown_symbol{ 0 };
         uint64_t m_next_order_id{ 1 };
         uint64_t m_global_seq{ 0 };
-        std::vector<TradeEvent> m_trades;
+        Sink m_sink;
 
         static uint64_t GetTimestampInNs()
         {
@@ -54,7 +91,7 @@ namespace hft
                 high_resolution_clock::now().time_since_epoch()).count();
         }
 
-        void ProcessNewOrder(Order order)
+        void ProcessNewOrder(Book &book, Order order)
         {
             if (order.id == 0) order.id = m_next_order_id++;
             order.sequence_id = ++m_global_seq;
@@ -62,7 +99,7 @@ namespace hft
             order.status = OrderStatus::ACTIVE;
 
             bool is_market = (order.type == OrderType::MARKET);
-            bool fully_filled = TryMatch(order, is_market);
+            bool fully_filled = TryMatch(book, order, is_market);
 
             if (!fully_filled)
             {
@@ -71,7 +108,7 @@ namespace hft
                 {
                     if (order.type == OrderType::LIMIT && order.tif == TimeInForce::GTC)
                     {
-                        m_orderbook.AddOrder(std::make_unique<Order>(order));
+                        if (!book.AddOrder(order)) { order.status = OrderStatus::REJECTED; }
                     }
                     else if (order.tif == TimeInForce::FOK)
                     {
@@ -95,13 +132,16 @@ namespace hft
             // NOTE(vss): we could log order acceptance + fills here
         }
 
-        bool TryMatch(Order &incoming_order, bool is_market)
+        bool TryMatch(Book &book, Order &incoming_order, bool is_market)
         {
             Side opposite_side = (incoming_order.side == Side::BUY) ? Side::SELL : Side::BUY;
 
             if (incoming_order.tif == TimeInForce::FOK)
             {
-                Quantity available = AvailableQuantityFor(incoming_order, is_market);
+                std::optional<Price> limit;
+                if (!is_market) { limit = incoming_order.price; }
+
+                Quantity available = book.AvailableQuantity(opposite_side, limit, incoming_order.RemainingQuantity());
                 if (available < incoming_order.RemainingQuantity())
                 {
                     incoming_order.status = OrderStatus::REJECTED;
@@ -109,17 +149,17 @@ namespace hft
                 }
             }
 
-            bool opposite_has = (opposite_side == Side::BUY) ? m_orderbook.HasBids() : m_orderbook.HasAsks();
+            bool opposite_has = (opposite_side == Side::BUY) ? book.HasBids() : book.HasAsks();
             if (!opposite_has && is_market) { return false; }
 
             while (incoming_order.RemainingQuantity() > 0)
             {
-                Order *maker = m_orderbook.GetBestOrder(opposite_side);
+                Order *maker = book.GetBestOrder(opposite_side);
                 if (!maker) { break; }
 
                 std::optional<Price> best_price;
-                if (opposite_side == Side::BUY) best_price = m_orderbook.BestBid();
-                else best_price = m_orderbook.BestAsk();
+                if (opposite_side == Side::BUY) best_price = book.BestBid();
+                else best_price = book.BestAsk();
 
                 if (!best_price.has_value()) { break; }
                 Price execution_price = best_price.value();
@@ -143,7 +183,6 @@ namespace hft
                 if (trade_qty == 0) { break; }
 
                 incoming_order.filled_qty += trade_qty;
-                maker->filled_qty += trade_qty;
 
                 TradeEvent event;
                 event.maker_order_id = maker->id;
@@ -151,12 +190,9 @@ namespace hft
                 event.price = execution_price;
                 event.quantity = trade_qty;
                 event.timestamp_ns = GetTimestampInNs();
-                m_trades.push_back(event);
+                m_sink.Emit(event);
 
-                if (maker->RemainingQuantity() == 0)
-                {
-                    m_orderbook.RemoveOrder(maker->id);
-                }
+                book.FillBestOrder(opposite_side, trade_qty);
             }
 
             if (incoming_order.RemainingQuantity() == 0)
@@ -172,53 +208,47 @@ namespace hft
             return false;
         }
 
-        Quantity AvailableQuantityFor(const Order &incoming_order, bool is_market)
+        // A modify that would cross the opposite touch is executed like a new
+        // aggressive order carrying the resting order's id and fills; anything
+        // else is handed to the book, which keeps priority on size-downs.
+        void ProcessModifyOrder(Book &book, const Order &target)
         {
-            Quantity sum = 0;
-            
-            // TODO(vss): this is not thread-safe across modifications!!
-            if (incoming_order.side == Side::BUY)
-            {
-                auto best_ask = m_orderbook.BestAsk();
-                while (best_ask)
-                {
-                    Price price = *best_ask;
-                    if (!is_market && incoming_order.price < price) { break; }
+            Order *resting = book.GetOrder(target.id);
+            if (!resting) { return; }
 
-                    Order *maker = m_orderbook.GetBestOrder(Side::SELL);
-                    if (!maker) { break; }
-
-                    sum += maker->RemainingQuantity();
-                    if (sum >= incoming_order.RemainingQuantity()) { return sum; }
-                    break;
-                }
+            bool crosses = false;
+            if (resting->side == Side::BUY)
+            {
+                auto best_ask = book.BestAsk();
+                crosses = best_ask && target.price >= *best_ask;
             }
             else
             {
-                auto best_bid = m_orderbook.BestBid();
-                while (best_bid)
-                {
-                    Price price = *best_bid;
-                    if (!is_market && incoming_order.price > price) { break; }
-
-                    Order *maker = m_orderbook.GetBestOrder(Side::BUY);
-                    if (!maker) { break; }
+                auto best_bid = book.BestBid();
+                crosses = best_bid && target.price <= *best_bid;
+            }
 
-                    sum += maker->RemainingQuantity();
-                    if (sum >= incoming_order.RemainingQuantity()) { return sum; }
-                    break;
-                }
+            if (!crosses)
+            {
+                book.ModifyOrder(target.id, target.price, target.quantity);
+                return;
             }
 
-            return sum;
+            Order order = *resting;
+            book.RemoveOrder(order.id);
+            if (target.quantity <= order.filled_qty) { return; }
+
+            order.price = target.price;
+            order.quantity = target.quantity;
+            ProcessNewOrder(book, order);
         }
 
-        void ProcessCancelOrder(OrderId order_id)
+        void ProcessCancelOrder(Book &book, OrderId order_id)
         {
-            Order *order = m_orderbook.GetOrder(order_id);
+            Order *order = book.GetOrder(order_id);
             if (!order) { return; }
             order->status = OrderStatus::CANCELLED;
-            m_orderbook.RemoveOrder(order_id);
+            book.RemoveOrder(order_id);
         }
     };
 
@@ -0,0 +1,138 @@
+#ifndef TRADE_SINK_H
+#define TRADE_SINK_H
+
+#include <vector>
+#include <span>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <concepts>
+
+#include "common/types.h"
+#include "ring_buffer/wait_strategy.h"
+
+namespace hft
+{
+    // Where MatchingEngine sends fills. Emit is called once per TradeEvent, in
+    // execution order, from inside the match loop, so a sink should not
+    // allocate or block on the common path.
+    template <typename Sink>
+    concept TradeSink = requires(Sink &sink, const TradeEvent &trade)
+    {
+        sink.Emit(trade);
+    };
+
+    // Collects trades into a vector that keeps its capacity across Clear(),
+    // so after warm-up the engine stops allocating. Default sink, mostly for
+    // tests and single-threaded use.
+    class VectorTradeSink
+    {
+    public:
+        explicit VectorTradeSink(size_t reserve = 256)
+        {
+            m_trades.reserve(reserve);
+        }
+
+        void Emit(const TradeEvent &trade) { m_trades.push_back(trade); }
+
+        std::span<const TradeEvent> Trades() const noexcept { return m_trades; }
+        void Clear() noexcept { m_trades.clear(); }
+
+    private:
+        std::vector<TradeEvent> m_trades;
+    };
+
+    // Forwards each trade to a callable.
+    template <typename Callback>
+        requires std::invocable<Callback &, const TradeEvent &>
+    class CallbackTradeSink
+    {
+    public:
+        explicit CallbackTradeSink(Callback callback)
+            : m_callback(std::move(callback))
+        { }
+
+        void Emit(const TradeEvent &trade) { m_callback(trade); }
+
+    private:
+        Callback m_callback;
+    };
+
+    // Writes into caller-owned storage. Trades past the end are counted
+    // rather than stored; the caller sizes the span for the worst burst.
+    class SpanTradeSink
+    {
+    public:
+        explicit SpanTradeSink(std::span<TradeEvent> storage) noexcept
+            : m_storage(storage)
+        { }
+
+        void Emit(const TradeEvent &trade) noexcept
+        {
+            if (m_size == m_storage.size())
+            {
+                ++m_overflow;
+                return;
+            }
+            m_storage[m_size++] = trade;
+        }
+
+        std::span<const TradeEvent> Trades() const noexcept { return m_storage.first(m_size); }
+        void Clear() noexcept { m_size = 0; }
+        uint64_t Overflow() const noexcept { return m_overflow; }
+
+    private:
+        std::span<TradeEvent> m_storage;
+        size_t m_size{ 0 };
+        uint64_t m_overflow{ 0 };
+    };
+
+    // Pushes straight into a ring (anything with bool TryPush(const TradeEvent&)).
+    // A full ring is back-pressure: the engine thread spins until the consumer
+    // catches up, unless the optional running flag drops, in which case the
+    // trade is counted as dropped so shutdown cannot hang. The engine usually
+    // wakes the consumer once per batch, so a consumer that may park passes
+    // its signal and wait config here too: a full ring wakes it before the
+    // sink spins, or a parked consumer would never drain it.
+    template <typename Ring>
+    class RingTradeSink
+    {
+    public:
+        explicit RingTradeSink(Ring &ring, const std::atomic<bool> *running = nullptr,
+                               WaitSignal *consumer_wakeup = nullptr, const WaitConfig &consumer_wait = { }) noexcept
+            : m_ring(&ring)
+            , m_running(running)
+            , m_consumer_wakeup(consumer_wakeup)
+            , m_consumer_wait(consumer_wait)
+        { }
+
+        void Emit(const TradeEvent &trade)
+        {
+            while (!m_ring->TryPush(trade))
+            {
+                if (m_running && !m_running->load(std::memory_order_relaxed))
+                {
+                    ++m_dropped;
+                    return;
+                }
+                if (m_consumer_wakeup) { Wake(m_consumer_wait, *m_consumer_wakeup); }
+                std::this_thread::yield();
+            }
+            ++m_emitted;
+        }
+
+        uint64_t Emitted() const noexcept { return m_emitted; }
+        uint64_t Dropped() const noexcept { return m_dropped; }
+
+    private:
+        Ring *m_ring;
+        const std::atomic<bool> *m_running;
+        WaitSignal *m_consumer_wakeup;
+        WaitConfig m_consumer_wait;
+        uint64_t m_emitted{ 0 };
+        uint64_t m_dropped{ 0 };
+    };
+
+} // namespace hft
+
+#endif // TRADE_SINK_H
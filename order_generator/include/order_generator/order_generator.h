@@ -3,8 +3,10 @@
 
 #include <random>
 #include <chrono>
-#include <unordered_set>
+#include <cmath>
+#include <algorithm>
 #include "common/types.h"
+#include "common/order_id_map.h"
 
 namespace hft
 {
@@ -20,7 +22,15 @@ namespace hft
         std::discrete_distribution<> m_tif_dist;
         std::exponential_distribution<> m_arrival_dist;
 
-        std::unordered_set<OrderId> m_active_orders;
+        // What the generator last told the engine about each live order, so
+        // modifies can be expressed relative to it.
+        struct ActiveOrder
+        {
+            Price price;
+            Quantity quantity;
+        };
+
+        OrderIdMap<ActiveOrder> m_active_orders;
         std::vector<OrderId> m_order_vector;
 
         double m_mid_price;
@@ -30,6 +40,7 @@ namespace hft
 
         size_t m_total_orders{ 0 };
         size_t m_total_cancels{ 0 };
+        size_t m_total_modifies{ 0 };
 
     public:
         OrderGenerator(uint32_t symbol_id = 1, double initial_mid_price = 100.0,
@@ -97,9 +108,7 @@ namespace hft
 
             double raw_price = m_price_dist(m_rng);
 
-            order.price = std::round(raw_price / m_tick_size) * m_tick_size;
-
-            order.price = std::max(m_tick_size, order.price);
+            order.price = Price{ std::llround(raw_price / m_tick_size) };
 
             order.quantity = std::max(1u, static_cast<uint32_t>(m_quantity_dist(m_rng)));
 
@@ -107,13 +116,15 @@ namespace hft
 
             if (order.side == Side::BUY)
             {
-                order.price -= m_tick_size * (1 + (m_rng() % 5));
+                order.price = order.price - static_cast<int64_t>(1 + (m_rng() % 5));
             }
             else
             {
-                order.price += m_tick_size * (1 + (m_rng() % 5));
+                order.price = order.price + static_cast<int64_t>(1 + (m_rng() % 5));
             }
 
+            order.price = std::max(Price{ 1 }, order.price);
+
             int tif_choice = m_tif_dist(m_rng);
             order.tif = (tif_choice == 0) ? TimeInForce::GTC : 
                         (tif_choice == 1) ? TimeInForce::IOC : TimeInForce::FOK;
@@ -121,7 +132,7 @@ namespace hft
             order.timestamp_ns = GetTimestamp();
             order.status = OrderStatus::ACTIVE;
 
-            m_active_orders.insert(order.id);
+            m_active_orders.InsertOrAssign(order.id, { order.price, order.quantity });
             m_order_vector.push_back(order.id);
             m_total_orders++;
 
@@ -141,12 +152,12 @@ namespace hft
             request.symbol_id = m_symbol_id;
             request.timestamp_ns = GetTimestamp();
 
-            if (!m_active_orders.empty())
+            if (!m_active_orders.Empty())
             {
                 size_t idx = m_rng() % m_order_vector.size();
                 request.order_id_to_cancel = m_order_vector[idx];
 
-                m_active_orders.erase(request.order_id_to_cancel);
+                m_active_orders.Erase(request.order_id_to_cancel);
                 m_order_vector.erase(m_order_vector.begin() + idx);
                 m_total_cancels++;
             }
@@ -160,11 +171,38 @@ namespace hft
 
         OrderRequest GenerateModifyOrder()
         {
-            if (!m_active_orders.empty())
+            if (m_active_orders.Empty())
+            {
+                return GenerateNewOrder();
+            }
+
+            OrderId order_id = m_order_vector[m_rng() % m_order_vector.size()];
+            ActiveOrder &active = *m_active_orders.Find(order_id);
+
+            // Half the time trim size in place, otherwise re-quote a few
+            // ticks away.
+            if (active.quantity > 1 && (m_rng() % 2) == 0)
             {
-                return GenerateCancelOrder();
+                active.quantity = std::max<Quantity>(1, active.quantity / 2);
             }
-            return GenerateNewOrder();
+            else
+            {
+                int64_t offset = static_cast<int64_t>(1 + (m_rng() % 3));
+                if (m_rng() % 2) { offset = -offset; }
+                active.price = std::max(Price{ 1 }, active.price + offset);
+            }
+
+            OrderRequest request;
+            request.type = RequestType::MODIFY_ORDER;
+            request.order.id = order_id;
+            request.order.symbol_id = m_symbol_id;
+            request.order.price = active.price;
+            request.order.quantity = active.quantity;
+            request.symbol_id = m_symbol_id;
+            request.timestamp_ns = GetTimestamp();
+
+            m_total_modifies++;
+            return request;
         }
 
         static uint64_t GetTimestamp()
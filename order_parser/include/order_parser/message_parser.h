@@ -3,6 +3,9 @@
 
 #include <variant>
 #include <chrono>
+#include <span>
+#include <vector>
+#include <cstddef>
 
 #include "protocol/message_dispatcher.h"
 #include "common/types.h"
@@ -14,7 +17,14 @@ namespace hft
     public:
         OrderRequest ParseMessage(const std::vector<uint8_t> &buffer)
         {
-            auto message = protocol::MessageDispatcher::Deserialize(buffer.data(), buffer.size());
+            return ParseMessage(std::as_bytes(std::span(buffer)));
+        }
+
+        // Parses straight out of a transport view (e.g. a ByteRingBuffer
+        // record) without copying into an owned buffer first.
+        OrderRequest ParseMessage(std::span<const std::byte> bytes)
+        {
+            auto message = protocol::MessageDispatcher::Deserialize(bytes.data(), bytes.size());
 
             OrderRequest request;
 
@@ -32,7 +42,7 @@ namespace hft
                     }
                     else if constexpr (std::is_same_v<T, protocol::ModifyOrderMessage>)
                     {
-                        throw std::runtime_error("Modify not implemented");
+                        request = HandleModify(msg);
                     }
                 }, message);
 
@@ -71,12 +81,12 @@ namespace hft
             }
         }
 
-        Order MessageToOrder(const protocol::NewOrderMessage &msg, double tick_size = 0.01)
+        Order MessageToOrder(const protocol::NewOrderMessage &msg)
         {
             Order order;
             order.id = msg.order_id;
             order.symbol_id = msg.symbol_id;
-            order.price = msg.price_ticks * tick_size;
+            order.price = Price{ msg.price_ticks };
             order.quantity = msg.quantity;
             order.side = ConvertSide(msg.side);
             order.tif = ConvertTif(msg.tif);
@@ -105,6 +115,19 @@ namespace hft
             return request;
         }
 
+        OrderRequest HandleModify(const protocol::ModifyOrderMessage &msg)
+        {
+            OrderRequest request;
+            request.type = RequestType::MODIFY_ORDER;
+            request.order.id = msg.order_id;
+            request.order.symbol_id = msg.symbol_id;
+            request.order.price = Price{ msg.new_price_ticks };
+            request.order.quantity = msg.new_quantity;
+            request.symbol_id = msg.symbol_id;
+            request.timestamp_ns = 0;
+            return request;
+        }
+
         uint64_t GetTimestamp()
         {
             return std::chrono::duration_cast<std::chrono::nanoseconds>(
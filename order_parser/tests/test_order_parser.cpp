@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <cstring>
+#include <array>
 
 #include "protocol/messages.h"
 #include "protocol/binary_codec.h"
@@ -46,6 +47,23 @@ static protocol::CancelOrderMessage MakeCancelMsg(uint64_t order_id,
     return m;
 }
 
+static protocol::ModifyOrderMessage MakeModifyMsg(uint64_t order_id,
+                                                  uint32_t symbol_id,
+                                                  uint32_t new_price_ticks,
+                                                  uint32_t new_quantity)
+{
+    protocol::ModifyOrderMessage m{ };
+    m.header.msg_length = sizeof(protocol::ModifyOrderMessage);
+    m.header.msg_type = protocol::MessageType::MODIFY_ORDER;
+    m.header.version = 1;
+    m.order_id = order_id;
+    m.symbol_id = symbol_id;
+    m.new_price_ticks = new_price_ticks;
+    m.new_quantity = new_quantity;
+    m.padding = 0;
+    return m;
+}
+
 TEST(MessageParser_NewOrder, ConvertsToOrderRequest) 
 {
     uint64_t order_id = 555;
@@ -64,7 +82,8 @@ TEST(MessageParser_NewOrder, ConvertsToOrderRequest)
     EXPECT_EQ(req.type, RequestType::NEW_ORDER);
     EXPECT_EQ(req.order.id, order_id);
     EXPECT_EQ(req.order.symbol_id, symbol_id);
-    EXPECT_DOUBLE_EQ(req.order.price, double(price_ticks) * 0.01);
+    EXPECT_EQ(req.order.price, Price{ price_ticks });
+    EXPECT_DOUBLE_EQ(ToDecimal(req.order.price), double(price_ticks) * 0.01);
     EXPECT_EQ(req.order.quantity, qty);
     EXPECT_EQ(req.order.side, Side::SELL);
     EXPECT_EQ(req.order.tif, TimeInForce::IOC);
@@ -91,3 +110,32 @@ TEST(MessageParser_InvalidBuffer, ThrowsOnBadInput)
     std::vector<uint8_t> tiny(2, 0);
     EXPECT_THROW(parser.ParseMessage(tiny), std::runtime_error);
 }
+
+TEST(MessageParser_ModifyOrder, ConvertsToModifyRequest)
+{
+    auto buf = protocol::BinaryCodec::Encode(MakeModifyMsg(777, 3, 10125, 40));
+
+    MessageParser parser;
+    auto req = parser.ParseMessage(buf);
+
+    EXPECT_EQ(req.type, RequestType::MODIFY_ORDER);
+    EXPECT_EQ(req.order.id, 777u);
+    EXPECT_EQ(req.symbol_id, 3u);
+    EXPECT_EQ(req.order.price, Price{ 10125 });
+    EXPECT_EQ(req.order.quantity, 40u);
+}
+
+TEST(MessageParser_Span, ParsesFromByteView)
+{
+    protocol::NewOrderMessage m = MakeNewOrderMsg(1, 2, 300, 4);
+    std::array<std::byte, sizeof(m)> storage;
+    std::memcpy(storage.data(), &m, sizeof(m));
+
+    MessageParser parser;
+    auto req = parser.ParseMessage(std::span<const std::byte>(storage));
+
+    EXPECT_EQ(req.type, RequestType::NEW_ORDER);
+    EXPECT_EQ(req.order.id, 1u);
+    EXPECT_EQ(req.order.price, Price{ 300 });
+    EXPECT_EQ(req.order.quantity, 4u);
+}
@@ -0,0 +1,99 @@
+#ifndef BOOK_MANAGER_H
+#define BOOK_MANAGER_H
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <stdexcept>
+#include <concepts>
+#include <algorithm>
+
+#include "common/types.h"
+
+namespace hft
+{
+    // One row of the static symbol reference table the engine is started with.
+    // The sizing hints let hot names preallocate deep pools and wide ladders
+    // while the long tail stays small: with the defaults an idle
+    // LadderOrderbook holds about 12 KiB (a 64-order pool chunk, a 128-slot
+    // id map and two 128-level ladders).
+    struct SymbolReference
+    {
+        uint32_t symbol_id;
+        size_t expected_orders{ 64 };
+        size_t window_ticks{ 128 };
+    };
+
+    // Owns one book per symbol, stored contiguously in reference-table order.
+    // Symbol ids are expected to be dense, so routing is two array loads:
+    // symbol id -> slot -> book, with no hashing on the engine thread.
+    template <typename Book>
+    class BookManager
+    {
+    public:
+        explicit BookManager(std::span<const SymbolReference> symbols)
+        {
+            uint32_t max_id = 0;
+            for (const auto &ref : symbols) { max_id = std::max(max_id, ref.symbol_id); }
+
+            m_slot_of.assign(symbols.empty() ? 0 : size_t{ max_id } + 1, InvalidSlot);
+            m_symbol_of.reserve(symbols.size());
+            m_books.reserve(symbols.size());
+
+            for (const auto &ref : symbols)
+            {
+                if (m_slot_of[ref.symbol_id] != InvalidSlot)
+                {
+                    throw std::invalid_argument("Duplicate symbol in reference table");
+                }
+
+                m_slot_of[ref.symbol_id] = static_cast<uint32_t>(m_books.size());
+                m_symbol_of.push_back(ref.symbol_id);
+                m_books.push_back(MakeBook(ref));
+            }
+        }
+
+        BookManager(const BookManager &) = delete;
+        BookManager &operator=(const BookManager &) = delete;
+
+        [[nodiscard]] Book *Find(uint32_t symbol_id) noexcept
+        {
+            if (symbol_id >= m_slot_of.size()) { return nullptr; }
+            const uint32_t slot = m_slot_of[symbol_id];
+            return (slot == InvalidSlot) ? nullptr : &m_books[slot];
+        }
+
+        [[nodiscard]] const Book *Find(uint32_t symbol_id) const noexcept
+        {
+            return const_cast<BookManager *>(this)->Find(symbol_id);
+        }
+
+        [[nodiscard]] size_t Size() const noexcept { return m_books.size(); }
+
+        // Slot-ordered access for reporting; slot i belongs to SymbolAt(i).
+        Book &BookAt(size_t slot) noexcept { return m_books[slot]; }
+        uint32_t SymbolAt(size_t slot) const noexcept { return m_symbol_of[slot]; }
+
+    private:
+        static constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> m_slot_of;
+        std::vector<uint32_t> m_symbol_of;
+        std::vector<Book> m_books;
+
+        static Book MakeBook(const SymbolReference &ref)
+        {
+            if constexpr (std::constructible_from<Book, size_t, size_t>)
+            {
+                return Book(ref.window_ticks, ref.expected_orders);
+            }
+            else
+            {
+                return Book(ref.expected_orders);
+            }
+        }
+    };
+
+} // namespace hft
+
+#endif // BOOK_MANAGER_H
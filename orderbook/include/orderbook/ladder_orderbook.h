@@ -0,0 +1,378 @@
+#ifndef LADDER_ORDERBOOK_H
+#define LADDER_ORDERBOOK_H
+
+#include <vector>
+#include <optional>
+#include <algorithm>
+
+#include "common/types.h"
+#include "common/order_id_map.h"
+#include "orderbook/orderbook.h"
+#include "orderbook/order_pool.h"
+#include "orderbook/level_bitmap.h"
+
+namespace hft
+{
+    // Same public surface as Orderbook, but price levels live in two contiguous
+    // arrays indexed by the tick offset from m_base. Best bid/ask are tracked as
+    // indices, so the touch is an array access instead of a tree walk, and a
+    // per-side LevelBitmap finds the next occupied level when the touch empties.
+    // When a price lands outside the window the ladder is recentred around the
+    // occupied range, or doubled if that range no longer fits. The window never
+    // grows past max_window_ticks; a price that would need more is rejected
+    // rather than letting one far-off order allocate gigabytes of levels.
+    class LadderOrderbook
+    {
+    public:
+        using LevelInfo = Orderbook::LevelInfo;
+        using Snapshot = Orderbook::Snapshot;
+
+        static constexpr size_t DefaultMaxWindowTicks = size_t{ 1 } << 20;
+
+        explicit LadderOrderbook(size_t window_ticks = 1024, size_t order_capacity = 4096,
+                                 size_t max_window_ticks = DefaultMaxWindowTicks)
+            : m_pool(order_capacity)
+            , m_order_info(order_capacity)
+            , m_bid_levels(std::max<size_t>(window_ticks, 2))
+            , m_ask_levels(std::max<size_t>(window_ticks, 2))
+            , m_bid_bits(m_bid_levels.size())
+            , m_ask_bits(m_ask_levels.size())
+            , m_max_window(std::max(max_window_ticks, m_bid_levels.size()))
+        { }
+
+        // Returns nullptr, leaving the book untouched, if the price is too far
+        // from the resting orders to fit in the largest allowed window.
+        Order *AddOrder(const Order &order)
+        {
+            Tick tick = order.price.value;
+            if (!EnsureInWindow(tick))
+            {
+                ++m_out_of_range;
+                return nullptr;
+            }
+            size_t idx = static_cast<size_t>(tick - m_base);
+
+            OrderHandle handle = m_pool.Acquire(order);
+            LinkToLevel(order.side, idx, handle, tick);
+
+            return &m_pool.Get(handle);
+        }
+
+        void RemoveOrder(OrderId order_id)
+        {
+            const OrderIndex *info = m_order_info.Find(order_id);
+            if (!info) { return; }
+
+            OrderHandle handle = info->handle;
+            size_t idx = static_cast<size_t>(info->tick - m_base);
+            m_order_info.Erase(order_id);
+
+            UnlinkFromLevel(m_pool.Get(handle).side, idx, handle);
+            m_pool.Release(handle);
+        }
+
+        // Reducing quantity at the same price updates the order and its level
+        // in place and keeps time priority. A price change or an increase
+        // moves the same pool node to the back of the target level. Returns
+        // false if the order is unknown, was removed because the new quantity
+        // is not above what has already filled, or was left as it was because
+        // the new price is out of range.
+        bool ModifyOrder(OrderId order_id, Price new_price, Quantity new_quantity)
+        {
+            const OrderIndex *info = m_order_info.Find(order_id);
+            if (!info) { return false; }
+
+            const OrderHandle handle = info->handle;
+            const Tick old_tick = info->tick;
+            Order &stored = m_pool.Get(handle);
+
+            if (new_quantity <= stored.filled_qty)
+            {
+                RemoveOrder(order_id);
+                return false;
+            }
+
+            const size_t old_idx = static_cast<size_t>(old_tick - m_base);
+            const Tick new_tick = new_price.value;
+            if (new_tick == old_tick && new_quantity <= stored.quantity)
+            {
+                auto &level = (stored.side == Side::BUY) ? m_bid_levels[old_idx] : m_ask_levels[old_idx];
+                level.level_qty -= stored.quantity - new_quantity;
+                stored.quantity = new_quantity;
+                return true;
+            }
+
+            if (!EnsureInWindow(new_tick))
+            {
+                ++m_out_of_range;
+                return false;
+            }
+
+            // A relocation moves every index, so recompute the old one.
+            UnlinkFromLevel(stored.side, static_cast<size_t>(old_tick - m_base), handle);
+            stored.price = new_price;
+            stored.quantity = new_quantity;
+
+            LinkToLevel(stored.side, static_cast<size_t>(new_tick - m_base), handle, new_tick);
+            return true;
+        }
+
+        Order *GetOrder(OrderId order_id)
+        {
+            const OrderIndex *info = m_order_info.Find(order_id);
+            if (!info) { return nullptr; }
+            return &m_pool.Get(info->handle);
+        }
+
+        bool HasBids() const { return m_bid_bits.Any(); }
+        bool HasAsks() const { return m_ask_bits.Any(); }
+
+        std::optional<Price> BestBid() const
+        {
+            if (m_best_bid == npos) { return std::nullopt; }
+            return Price{ m_base + static_cast<Tick>(m_best_bid) };
+        }
+
+        std::optional<Price> BestAsk() const
+        {
+            if (m_best_ask == npos) { return std::nullopt; }
+            return Price{ m_base + static_cast<Tick>(m_best_ask) };
+        }
+
+        Order *GetBestOrder(Side side)
+        {
+            if (side == Side::BUY)
+            {
+                if (m_best_bid == npos) { return nullptr; }
+                return &m_pool.Get(m_bid_levels[m_best_bid].level_orders.Front());
+            }
+            else
+            {
+                if (m_best_ask == npos) { return nullptr; }
+                return &m_pool.Get(m_ask_levels[m_best_ask].level_orders.Front());
+            }
+        }
+
+        // See Orderbook::AvailableQuantity. Walks occupied levels via the
+        // bitmap and reads only the level aggregates.
+        Quantity AvailableQuantity(Side side, std::optional<Price> limit, Quantity wanted) const
+        {
+            Quantity sum = 0;
+            if (side == Side::BUY)
+            {
+                for (size_t idx = m_best_bid; idx != npos; idx = NextBidFrom(idx))
+                {
+                    if (limit && Price{ m_base + static_cast<Tick>(idx) } < *limit) { break; }
+                    sum += m_bid_levels[idx].level_qty;
+                    if (sum >= wanted) { break; }
+                }
+            }
+            else
+            {
+                for (size_t idx = m_best_ask; idx != npos; idx = NextAskFrom(idx))
+                {
+                    if (limit && Price{ m_base + static_cast<Tick>(idx) } > *limit) { break; }
+                    sum += m_ask_levels[idx].level_qty;
+                    if (sum >= wanted) { break; }
+                }
+            }
+            return sum;
+        }
+
+        void FillBestOrder(Side side, Quantity qty)
+        {
+            auto &level = (side == Side::BUY) ? m_bid_levels[m_best_bid] : m_ask_levels[m_best_ask];
+            Order &maker = m_pool.Get(level.level_orders.Front());
+            maker.filled_qty += qty;
+            level.level_qty -= qty;
+
+            if (maker.RemainingQuantity() == 0)
+            {
+                RemoveOrder(maker.id);
+            }
+        }
+
+        Snapshot SnapshotTop(size_t depth = 5) const
+        {
+            Snapshot snap;
+            snap.seq = m_seq_num;
+
+            for (size_t idx = m_best_bid; idx != npos && snap.bids.size() < depth; idx = NextBidFrom(idx))
+            {
+                const auto &level = m_bid_levels[idx];
+                snap.bids.push_back({ Price{ m_base + static_cast<Tick>(idx) }, level.level_qty, level.level_orders.Size() });
+            }
+
+            for (size_t idx = m_best_ask; idx != npos && snap.asks.size() < depth; idx = NextAskFrom(idx))
+            {
+                const auto &level = m_ask_levels[idx];
+                snap.asks.push_back({ Price{ m_base + static_cast<Tick>(idx) }, level.level_qty, level.level_orders.Size() });
+            }
+
+            return snap;
+        }
+
+        size_t WindowTicks() const { return m_bid_levels.size(); }
+        uint64_t OutOfRangeCount() const { return m_out_of_range; }
+
+    private:
+        using Tick = int64_t;
+        static constexpr size_t npos = LevelBitmap::npos;
+
+        struct LevelData
+        {
+            OrderQueue level_orders;
+            Quantity level_qty{ 0 };
+        };
+
+        struct OrderIndex
+        {
+            Tick tick;
+            OrderHandle handle;
+        };
+
+        OrderPool m_pool;
+        OrderIdMap<OrderIndex> m_order_info;
+        Tick m_base{ 0 };
+        std::vector<LevelData> m_bid_levels;
+        std::vector<LevelData> m_ask_levels;
+        size_t m_best_bid{ npos };
+        size_t m_best_ask{ npos };
+        LevelBitmap m_bid_bits;
+        LevelBitmap m_ask_bits;
+        size_t m_max_window;
+        uint64_t m_out_of_range{ 0 };
+        uint64_t m_seq_num = 0;
+
+        void PushToLevel(LevelData &level, LevelBitmap &bits, size_t idx, OrderHandle handle, Tick tick)
+        {
+            const Order &stored = m_pool.Get(handle);
+            if (level.level_orders.Empty())
+            {
+                bits.Set(idx);
+            }
+
+            level.level_orders.PushBack(m_pool, handle);
+            level.level_qty += stored.RemainingQuantity();
+            m_order_info.InsertOrAssign(stored.id, { tick, handle });
+        }
+
+        void LinkToLevel(Side side, size_t idx, OrderHandle handle, Tick tick)
+        {
+            if (side == Side::BUY)
+            {
+                PushToLevel(m_bid_levels[idx], m_bid_bits, idx, handle, tick);
+                if (m_best_bid == npos || idx > m_best_bid) { m_best_bid = idx; }
+            }
+            else
+            {
+                PushToLevel(m_ask_levels[idx], m_ask_bits, idx, handle, tick);
+                if (m_best_ask == npos || idx < m_best_ask) { m_best_ask = idx; }
+            }
+        }
+
+        // Takes the order out of its level queue; the pool node and the
+        // id index are left to the caller.
+        void UnlinkFromLevel(Side side, size_t idx, OrderHandle handle)
+        {
+            const Order &stored = m_pool.Get(handle);
+            if (side == Side::BUY)
+            {
+                auto &level = m_bid_levels[idx];
+                level.level_qty -= stored.RemainingQuantity();
+                level.level_orders.Erase(m_pool, handle);
+                if (level.level_orders.Empty())
+                {
+                    level.level_qty = 0;
+                    m_bid_bits.Clear(idx);
+                    if (idx == m_best_bid) { m_best_bid = NextBidFrom(idx); }
+                }
+            }
+            else
+            {
+                auto &level = m_ask_levels[idx];
+                level.level_qty -= stored.RemainingQuantity();
+                level.level_orders.Erase(m_pool, handle);
+                if (level.level_orders.Empty())
+                {
+                    level.level_qty = 0;
+                    m_ask_bits.Clear(idx);
+                    if (idx == m_best_ask) { m_best_ask = NextAskFrom(idx); }
+                }
+            }
+        }
+
+        size_t NextBidFrom(size_t idx) const
+        {
+            return (idx == 0) ? npos : m_bid_bits.FindPrev(idx - 1);
+        }
+
+        size_t NextAskFrom(size_t idx) const
+        {
+            return m_ask_bits.FindNext(idx + 1);
+        }
+
+        bool EnsureInWindow(Tick tick)
+        {
+            const size_t window = m_bid_levels.size();
+            if (tick >= m_base && tick < m_base + static_cast<Tick>(window)) { return true; }
+
+            if (!m_bid_bits.Any() && !m_ask_bits.Any())
+            {
+                m_base = tick - static_cast<Tick>(window / 2);
+                return true;
+            }
+
+            Tick lo = tick;
+            Tick hi = tick;
+            for (const LevelBitmap *bits : { &m_bid_bits, &m_ask_bits })
+            {
+                if (!bits->Any()) { continue; }
+                lo = std::min(lo, m_base + static_cast<Tick>(bits->First()));
+                hi = std::max(hi, m_base + static_cast<Tick>(bits->Last()));
+            }
+
+            // Keep at least half the window as headroom so a drifting touch
+            // does not immediately trigger another recentre.
+            const size_t span = static_cast<size_t>(hi - lo) + 1;
+            if (span > m_max_window) { return false; }
+
+            size_t new_window = window;
+            while (new_window < 2 * span && new_window < m_max_window) { new_window *= 2; }
+            new_window = std::min(new_window, m_max_window);
+
+            const Tick new_base = lo - static_cast<Tick>((new_window - span) / 2);
+            Relocate(new_base, new_window);
+            return true;
+        }
+
+        void Relocate(Tick new_base, size_t new_window)
+        {
+            // Queues only hold pool handles and OrderIndex is keyed by tick,
+            // so only occupied levels, their bits and the best indices move.
+            const Tick shift = m_base - new_base;
+            auto relocate_side = [shift, new_window](std::vector<LevelData> &levels, LevelBitmap &bits, size_t &best)
+                {
+                    std::vector<LevelData> moved(new_window);
+                    LevelBitmap moved_bits(new_window);
+                    for (size_t idx = bits.First(); idx != npos; idx = bits.FindNext(idx + 1))
+                    {
+                        const size_t to = static_cast<size_t>(static_cast<Tick>(idx) + shift);
+                        moved[to] = levels[idx];
+                        moved_bits.Set(to);
+                    }
+
+                    if (best != npos) { best = static_cast<size_t>(static_cast<Tick>(best) + shift); }
+                    levels.swap(moved);
+                    bits = std::move(moved_bits);
+                };
+
+            relocate_side(m_bid_levels, m_bid_bits, m_best_bid);
+            relocate_side(m_ask_levels, m_ask_bits, m_best_ask);
+            m_base = new_base;
+        }
+    };
+
+} // namespace hft
+
+#endif // LADDER_ORDERBOOK_H
@@ -0,0 +1,141 @@
+#ifndef LEVEL_BITMAP_H
+#define LEVEL_BITMAP_H
+
+#include <vector>
+#include <bit>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace hft
+{
+    // Hierarchical occupancy bitmap over ladder indices. Level 0 has one bit per
+    // index, every level above has one bit per non-zero word of the level below,
+    // until a single word summarises everything. 4096 ticks need two levels and
+    // 262144 need three. Next/previous set bit costs one countr_zero/countl_zero
+    // per level on the way up and again on the way down, however sparse the
+    // ladder is.
+    class LevelBitmap
+    {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        explicit LevelBitmap(size_t bits = 0)
+        {
+            Resize(bits);
+        }
+
+        // Drops all bits.
+        void Resize(size_t bits)
+        {
+            m_bits = bits;
+            m_levels.clear();
+
+            size_t count = bits;
+            do
+            {
+                count = (count + WordBits - 1) / WordBits;
+                m_levels.emplace_back(std::max<size_t>(count, 1), 0);
+            } while (count > 1);
+        }
+
+        size_t Bits() const noexcept { return m_bits; }
+
+        bool Test(size_t pos) const noexcept
+        {
+            return (m_levels[0][pos / WordBits] >> (pos % WordBits)) & 1u;
+        }
+
+        bool Any() const noexcept { return m_levels.back()[0] != 0; }
+
+        void Set(size_t pos) noexcept
+        {
+            for (auto &level : m_levels)
+            {
+                uint64_t &word = level[pos / WordBits];
+                const bool was_empty = (word == 0);
+                word |= uint64_t{ 1 } << (pos % WordBits);
+                if (!was_empty) { return; }
+                pos /= WordBits;
+            }
+        }
+
+        void Clear(size_t pos) noexcept
+        {
+            for (auto &level : m_levels)
+            {
+                uint64_t &word = level[pos / WordBits];
+                word &= ~(uint64_t{ 1 } << (pos % WordBits));
+                if (word != 0) { return; }
+                pos /= WordBits;
+            }
+        }
+
+        // Lowest set index >= pos, or npos.
+        size_t FindNext(size_t pos) const noexcept
+        {
+            if (pos >= m_bits) { return npos; }
+
+            size_t level = 0;
+            for (;;)
+            {
+                const size_t w = pos / WordBits;
+                const uint64_t bits = m_levels[level][w] & (~uint64_t{ 0 } << (pos % WordBits));
+                if (bits)
+                {
+                    pos = w * WordBits + std::countr_zero(bits);
+                    break;
+                }
+
+                pos = w + 1;
+                if (++level == m_levels.size() || pos >= m_levels[level - 1].size()) { return npos; }
+            }
+
+            while (level-- > 0)
+            {
+                pos = pos * WordBits + std::countr_zero(m_levels[level][pos]);
+            }
+            return pos;
+        }
+
+        // Highest set index <= pos, or npos.
+        size_t FindPrev(size_t pos) const noexcept
+        {
+            if (m_bits == 0 || pos == npos) { return npos; }
+            if (pos >= m_bits) { pos = m_bits - 1; }
+
+            size_t level = 0;
+            for (;;)
+            {
+                const size_t w = pos / WordBits;
+                const uint64_t bits = m_levels[level][w] & (~uint64_t{ 0 } >> (WordBits - 1 - pos % WordBits));
+                if (bits)
+                {
+                    pos = w * WordBits + (WordBits - 1 - std::countl_zero(bits));
+                    break;
+                }
+
+                if (w == 0 || ++level == m_levels.size()) { return npos; }
+                pos = w - 1;
+            }
+
+            while (level-- > 0)
+            {
+                pos = pos * WordBits + (WordBits - 1 - std::countl_zero(m_levels[level][pos]));
+            }
+            return pos;
+        }
+
+        size_t First() const noexcept { return FindNext(0); }
+        size_t Last() const noexcept { return FindPrev(m_bits - 1); }
+
+    private:
+        static constexpr size_t WordBits = 64;
+
+        size_t m_bits{ 0 };
+        std::vector<std::vector<uint64_t>> m_levels;
+    };
+
+} // namespace hft
+
+#endif // LEVEL_BITMAP_H
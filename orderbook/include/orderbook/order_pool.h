@@ -0,0 +1,168 @@
+#ifndef ORDER_POOL_H
+#define ORDER_POOL_H
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <bit>
+#include <algorithm>
+#include <stdexcept>
+
+#include "common/types.h"
+
+namespace hft
+{
+    using OrderHandle = uint32_t;
+    inline constexpr OrderHandle InvalidOrderHandle = std::numeric_limits<OrderHandle>::max();
+
+    // Preallocated storage for resting orders. Each node carries intrusive
+    // prev/next handles, so per-level FIFO queues need no extra allocation.
+    // Storage is split into fixed-size chunks: nodes never move, Order* stays
+    // valid until Release, and running out of capacity adds a chunk instead
+    // of reallocating. Free nodes are threaded through `next`.
+    class OrderPool
+    {
+    public:
+        explicit OrderPool(size_t capacity = 4096)
+            : m_chunk_shift(std::bit_width(std::bit_ceil(std::max<size_t>(capacity, MinChunkSize)) - 1))
+            , m_chunk_mask((OrderHandle{ 1 } << m_chunk_shift) - 1)
+        {
+            AddChunk();
+        }
+
+        OrderPool(const OrderPool &) = delete;
+        OrderPool &operator=(const OrderPool &) = delete;
+        OrderPool(OrderPool &&) noexcept = default;
+        OrderPool &operator=(OrderPool &&) noexcept = default;
+
+        [[nodiscard]] OrderHandle Acquire(const Order &order)
+        {
+            if (m_free_head == InvalidOrderHandle)
+            {
+                AddChunk();
+            }
+
+            OrderHandle handle = m_free_head;
+            Node &node = NodeAt(handle);
+            m_free_head = node.next;
+
+            node.order = order;
+            node.prev = InvalidOrderHandle;
+            node.next = InvalidOrderHandle;
+            ++m_size;
+            return handle;
+        }
+
+        void Release(OrderHandle handle) noexcept
+        {
+            Node &node = NodeAt(handle);
+            node.prev = InvalidOrderHandle;
+            node.next = m_free_head;
+            m_free_head = handle;
+            --m_size;
+        }
+
+        Order &Get(OrderHandle handle) noexcept { return NodeAt(handle).order; }
+        const Order &Get(OrderHandle handle) const noexcept { return NodeAt(handle).order; }
+
+        OrderHandle &Next(OrderHandle handle) noexcept { return NodeAt(handle).next; }
+        OrderHandle &Prev(OrderHandle handle) noexcept { return NodeAt(handle).prev; }
+        OrderHandle Next(OrderHandle handle) const noexcept { return NodeAt(handle).next; }
+
+        size_t Size() const noexcept { return m_size; }
+        size_t Capacity() const noexcept { return m_chunks.size() << m_chunk_shift; }
+
+    private:
+        static constexpr size_t MinChunkSize = 64;
+
+        struct Node
+        {
+            Order order;
+            OrderHandle prev;
+            OrderHandle next;
+        };
+
+        uint32_t m_chunk_shift;
+        OrderHandle m_chunk_mask;
+        std::vector<std::unique_ptr<Node[]>> m_chunks;
+        OrderHandle m_free_head{ InvalidOrderHandle };
+        size_t m_size{ 0 };
+
+        Node &NodeAt(OrderHandle handle) noexcept
+        {
+            return m_chunks[handle >> m_chunk_shift][handle & m_chunk_mask];
+        }
+
+        const Node &NodeAt(OrderHandle handle) const noexcept
+        {
+            return m_chunks[handle >> m_chunk_shift][handle & m_chunk_mask];
+        }
+
+        void AddChunk()
+        {
+            const size_t chunk_size = size_t{ 1 } << m_chunk_shift;
+            const size_t first = m_chunks.size() * chunk_size;
+            if (first + chunk_size > InvalidOrderHandle)
+            {
+                throw std::length_error("OrderPool handle space exhausted");
+            }
+
+            auto chunk = std::make_unique_for_overwrite<Node[]>(chunk_size);
+
+            // Thread the new chunk onto the free list in ascending order so
+            // consecutive acquires walk memory forwards.
+            for (size_t i = 0; i < chunk_size; ++i)
+            {
+                chunk[i].prev = InvalidOrderHandle;
+                chunk[i].next = (i + 1 < chunk_size) ? static_cast<OrderHandle>(first + i + 1) : m_free_head;
+            }
+
+            m_chunks.push_back(std::move(chunk));
+            m_free_head = static_cast<OrderHandle>(first);
+        }
+    };
+
+    // FIFO of pooled orders at one price level, linked through the pool's
+    // intrusive handles. Push, erase and front are all O(1).
+    struct OrderQueue
+    {
+        OrderHandle head{ InvalidOrderHandle };
+        OrderHandle tail{ InvalidOrderHandle };
+        uint32_t count{ 0 };
+
+        bool Empty() const noexcept { return count == 0; }
+        size_t Size() const noexcept { return count; }
+        OrderHandle Front() const noexcept { return head; }
+
+        void PushBack(OrderPool &pool, OrderHandle handle) noexcept
+        {
+            pool.Prev(handle) = tail;
+            pool.Next(handle) = InvalidOrderHandle;
+
+            if (tail != InvalidOrderHandle) { pool.Next(tail) = handle; }
+            else { head = handle; }
+
+            tail = handle;
+            ++count;
+        }
+
+        void Erase(OrderPool &pool, OrderHandle handle) noexcept
+        {
+            OrderHandle prev = pool.Prev(handle);
+            OrderHandle next = pool.Next(handle);
+
+            if (prev != InvalidOrderHandle) { pool.Next(prev) = next; }
+            else { head = next; }
+
+            if (next != InvalidOrderHandle) { pool.Prev(next) = prev; }
+            else { tail = prev; }
+
+            pool.Prev(handle) = InvalidOrderHandle;
+            pool.Next(handle) = InvalidOrderHandle;
+            --count;
+        }
+    };
+
+} // namespace hft
+
+#endif // ORDER_POOL_H
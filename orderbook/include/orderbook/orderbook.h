@@ -3,99 +3,78 @@
 
 #include <map>
 #include <vector>
-#include <list>
-#include <unordered_map>
-#include <memory>
 #include <optional>
 
 #include "common/types.h"
+#include "common/order_id_map.h"
+#include "orderbook/order_pool.h"
 
 namespace hft
 {
     class Orderbook
     {
     public:
-        Orderbook() = default;
+        explicit Orderbook(size_t order_capacity = 4096)
+            : m_pool(order_capacity)
+            , m_order_info(order_capacity)
+        { }
 
-        void AddOrder(std::unique_ptr<Order> order)
+        Order *AddOrder(const Order &order)
         {
-            if (!order) { return; }
-
-            Price price = order->price;
-            if (order->side == Side::BUY)
-            {
-                auto &level = m_bids[price];
-                level.level_orders.push_back(std::move(order));
-                auto it = std::prev(level.level_orders.end());
-                level.level_qty += (*it)->RemainingQuantity();
-                m_order_info[(*it)->id] = { price, it };
-            }
-            else
-            {
-                auto &level = m_asks[price];
-                level.level_orders.push_back(std::move(order));
-                auto it = std::prev(level.level_orders.end());
-                level.level_qty += (*it)->RemainingQuantity();
-                m_order_info[(*it)->id] = { price, it };
-            }
-            
+            OrderHandle handle = m_pool.Acquire(order);
+            LinkToLevel(handle);
+            return &m_pool.Get(handle);
         }
 
         void RemoveOrder(OrderId order_id)
         {
-            auto order_it = m_order_info.find(order_id);
-            if (order_it == m_order_info.end()) { return; }
-            Price price = order_it->second.price;
-            auto &it = order_it->second.it;
+            const OrderIndex *info = m_order_info.Find(order_id);
+            if (!info) { return; }
+            OrderHandle handle = info->handle;
 
-            Order *stored = it->get();
-            if (!stored)
-            {
-                m_order_info.erase(order_it);
-                return;
-            }
+            UnlinkFromLevel(handle);
+            m_pool.Release(handle);
+            m_order_info.Erase(order_id);
+        }
+
+        // Reducing quantity at the same price is an in-place update that keeps
+        // time priority. A price change or an increase moves the same pool
+        // node to the back of the target level. Returns false if the order is
+        // unknown or was removed because nothing would be left to fill.
+        bool ModifyOrder(OrderId order_id, Price new_price, Quantity new_quantity)
+        {
+            const OrderIndex *info = m_order_info.Find(order_id);
+            if (!info) { return false; }
+
+            const OrderHandle handle = info->handle;
+            Order &stored = m_pool.Get(handle);
 
-            if (stored->side == Side::BUY) 
+            if (new_quantity <= stored.filled_qty)
             {
-                auto level_it = m_bids.find(price);
-                if (level_it != m_bids.end()) 
-                {
-                    level_it->second.level_qty -= (*it)->RemainingQuantity();
-                    level_it->second.level_orders.erase(it);
-                    if (level_it->second.level_orders.empty())
-                    {
-                        m_bids.erase(level_it);
-                    }
-                }
+                RemoveOrder(order_id);
+                return false;
             }
-            else 
+
+            if (new_price == stored.price && new_quantity <= stored.quantity)
             {
-                auto level_it = m_asks.find(price);
-                if (level_it != m_asks.end()) 
-                {
-                    level_it->second.level_qty -= (*it)->RemainingQuantity();
-                    level_it->second.level_orders.erase(it);
-                    if (level_it->second.level_orders.empty()) 
-                    {
-                        m_asks.erase(level_it);
-                    }
-                }
+                auto &level = (stored.side == Side::BUY) ? m_bids.find(stored.price)->second : m_asks.find(stored.price)->second;
+                level.level_qty -= stored.quantity - new_quantity;
+                stored.quantity = new_quantity;
+                return true;
             }
 
-            m_order_info.erase(order_it);
-        }
-
-        void ModifyOrder(OrderId order_id)
-        {
-            // TODO
-            return;
+            UnlinkFromLevel(handle);
+            stored.price = new_price;
+            stored.quantity = new_quantity;
+            LinkToLevel(handle);
+            return true;
         }
 
         Order *GetOrder(OrderId order_id)
         {
-            auto order_it = m_order_info.find(order_id);
-            if (order_it == m_order_info.end()) { return nullptr; }
-            return order_it->second.it->get();
+            const OrderIndex *info = m_order_info.Find(order_id);
+            if (!info) { return nullptr; }
+            return &m_pool.Get(info->handle);
         }
 
         bool HasBids() const { return !m_bids.empty(); }
@@ -119,15 +98,55 @@ namespace hft
             {
                 if (m_bids.empty()) { return nullptr; }
                 auto &level = m_bids.begin()->second;
-                if (level.level_orders.empty()) { return nullptr; }
-                return level.level_orders.front().get();
+                if (level.level_orders.Empty()) { return nullptr; }
+                return &m_pool.Get(level.level_orders.Front());
             }
             else
             {
                 if (m_asks.empty()) { return nullptr; }
                 auto &level = m_asks.begin()->second;
-                if (level.level_orders.empty()) { return nullptr; }
-                return level.level_orders.front().get();
+                if (level.level_orders.Empty()) { return nullptr; }
+                return &m_pool.Get(level.level_orders.Front());
+            }
+        }
+
+        // Resting quantity on `side` that an aggressor limited to `limit`
+        // could take (nullopt = market), summed from the level aggregates.
+        // Stops as soon as `wanted` is reached, so the cost is bounded by the
+        // number of levels crossed, never by queue depth.
+        Quantity AvailableQuantity(Side side, std::optional<Price> limit, Quantity wanted) const
+        {
+            auto sum_levels = [limit, wanted](const auto &levels, auto outside_limit)
+                {
+                    Quantity sum = 0;
+                    for (const auto &[price, level] : levels)
+                    {
+                        if (limit && outside_limit(price, *limit)) { break; }
+                        sum += level.level_qty;
+                        if (sum >= wanted) { break; }
+                    }
+                    return sum;
+                };
+
+            if (side == Side::BUY)
+            {
+                return sum_levels(m_bids, [](Price price, Price lim) { return price < lim; });
+            }
+            return sum_levels(m_asks, [](Price price, Price lim) { return price > lim; });
+        }
+
+        // Fills `qty` against the front order of `side`'s best level and keeps
+        // the level aggregate in step. The order leaves the book once filled.
+        void FillBestOrder(Side side, Quantity qty)
+        {
+            auto &level = (side == Side::BUY) ? m_bids.begin()->second : m_asks.begin()->second;
+            Order &maker = m_pool.Get(level.level_orders.Front());
+            maker.filled_qty += qty;
+            level.level_qty -= qty;
+
+            if (maker.RemainingQuantity() == 0)
+            {
+                RemoveOrder(maker.id);
             }
         }
 
@@ -151,13 +170,13 @@ namespace hft
             size_t count = 0;
             for (auto it = m_bids.begin(); it != m_bids.end() && count < depth; ++it, ++count)
             {
-                snap.bids.push_back({ it->first, it->second.level_qty, it->second.level_orders.size() });
+                snap.bids.push_back({ it->first, it->second.level_qty, it->second.level_orders.Size() });
             }
 
             count = 0;
             for (auto it = m_asks.begin(); it != m_asks.end() && count < depth; ++it, ++count)
             {
-                snap.asks.push_back({ it->first, it->second.level_qty, it->second.level_orders.size() });
+                snap.asks.push_back({ it->first, it->second.level_qty, it->second.level_orders.Size() });
             }
 
             return snap;
@@ -165,20 +184,52 @@ namespace hft
     private:
         struct LevelData
         {
-            std::list<std::unique_ptr<Order>> level_orders;
-            Quantity level_qty;
+            OrderQueue level_orders;
+            Quantity level_qty{ 0 };
         };
 
         struct OrderIndex
         {
             Price price;
-            std::list<std::unique_ptr<Order>>::iterator it;
+            OrderHandle handle;
         };
 
-        std::unordered_map<OrderId, OrderIndex> m_order_info;
+        OrderPool m_pool;
+        OrderIdMap<OrderIndex> m_order_info;
         std::map<Price, LevelData, std::greater<Price>> m_bids;
         std::map<Price, LevelData, std::less<Price>> m_asks;
         uint64_t m_seq_num = 0;
+
+        void LinkToLevel(OrderHandle handle)
+        {
+            const Order &stored = m_pool.Get(handle);
+            auto &level = (stored.side == Side::BUY) ? m_bids[stored.price] : m_asks[stored.price];
+            level.level_orders.PushBack(m_pool, handle);
+            level.level_qty += stored.RemainingQuantity();
+            m_order_info.InsertOrAssign(stored.id, { stored.price, handle });
+        }
+
+        // Takes the order out of its level queue and drops the level once
+        // empty; the pool node and the id index are left to the caller.
+        void UnlinkFromLevel(OrderHandle handle)
+        {
+            const Order &stored = m_pool.Get(handle);
+            auto unlink = [this, &stored, handle](auto &levels)
+                {
+                    auto level_it = levels.find(stored.price);
+                    if (level_it == levels.end()) { return; }
+
+                    level_it->second.level_qty -= stored.RemainingQuantity();
+                    level_it->second.level_orders.Erase(m_pool, handle);
+                    if (level_it->second.level_orders.Empty())
+                    {
+                        levels.erase(level_it);
+                    }
+                };
+
+            if (stored.side == Side::BUY) { unlink(m_bids); }
+            else { unlink(m_asks); }
+        }
     };
 
 } //namespace hft
@@ -0,0 +1,61 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "alloc_counter.h"
+
+// Replaces every global allocation form with a counting malloc/free pair.
+// Kept in its own translation unit so the compiler cannot inline these into
+// call sites where it also sees the builtin operator new, which is what
+// -Wmismatched-new-delete trips over.
+
+namespace
+{
+    std::atomic<size_t> g_allocations{ 0 };
+
+    void *Allocate(std::size_t size)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void *p = std::malloc(size ? size : 1)) { return p; }
+        throw std::bad_alloc();
+    }
+
+    void *AllocateAligned(std::size_t size, std::align_val_t align)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t alignment = static_cast<std::size_t>(align);
+#if defined(_WIN32)
+        void *p = _aligned_malloc(size ? size : 1, alignment);
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment.
+        void *p = std::aligned_alloc(alignment, ((size ? size : 1) + alignment - 1) / alignment * alignment);
+#endif
+        if (p) { return p; }
+        throw std::bad_alloc();
+    }
+
+    void FreeAligned(void *p) noexcept
+    {
+#if defined(_WIN32)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+size_t AllocationCount() noexcept { return g_allocations.load(std::memory_order_relaxed); }
+
+void *operator new(std::size_t size) { return Allocate(size); }
+void *operator new[](std::size_t size) { return Allocate(size); }
+void *operator new(std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
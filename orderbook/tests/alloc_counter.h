@@ -0,0 +1,10 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstddef>
+
+// Number of global operator new calls (every form) made by the test binary
+// so far, so the book paths can assert on heap activity.
+size_t AllocationCount() noexcept;
+
+#endif // ALLOC_COUNTER_H
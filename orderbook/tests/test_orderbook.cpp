@@ -1,17 +1,25 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <set>
+
 #include "orderbook/orderbook.h"  // includes types.h
+#include "orderbook/ladder_orderbook.h"
+#include "orderbook/order_pool.h"
+#include "orderbook/level_bitmap.h"
+#include "orderbook/book_manager.h"
+#include "alloc_counter.h"
 
 using namespace hft;
 
-static std::unique_ptr<Order> NewOrderPtr(OrderId id, Side side, Price price, Quantity qty) 
+static Order NewOrder(OrderId id, Side side, Price price, Quantity qty) 
 {
-    auto order = std::make_unique<Order>();
-    order->id = id;
-    order->side = side;
-    order->price = price;
-    order->quantity = qty;
-    order->filled_qty = 0;
-    order->status = OrderStatus::ACTIVE;
+    Order order{ };
+    order.id = id;
+    order.side = side;
+    order.price = price;
+    order.quantity = qty;
+    order.filled_qty = 0;
+    order.status = OrderStatus::ACTIVE;
     return order;
 }
 
@@ -19,17 +27,17 @@ TEST(OrderbookBasic, AddGetRemoveBestPrice)
 {
     Orderbook ob;
 
-    ob.AddOrder(NewOrderPtr(1, Side::BUY, 101.0, 10));
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 10100 }, 10));
     EXPECT_TRUE(ob.HasBids());
     auto best_bid = ob.BestBid();
     ASSERT_TRUE(best_bid.has_value());
-    EXPECT_DOUBLE_EQ(*best_bid, 101.0);
+    EXPECT_EQ(*best_bid, Price{ 10100 });
 
-    ob.AddOrder(NewOrderPtr(2, Side::SELL, 102.0, 5));
+    ob.AddOrder(NewOrder(2, Side::SELL, Price{ 10200 }, 5));
     EXPECT_TRUE(ob.HasAsks());
     auto best_ask = ob.BestAsk();
     ASSERT_TRUE(best_ask.has_value());
-    EXPECT_DOUBLE_EQ(*best_ask, 102.0);
+    EXPECT_EQ(*best_ask, Price{ 10200 });
 
     ob.RemoveOrder(1);
     EXPECT_FALSE(ob.HasBids());
@@ -39,8 +47,8 @@ TEST(OrderbookFIFO, SamePriceMaintainsFIFO)
 {
     Orderbook ob;
 
-    ob.AddOrder(NewOrderPtr(10, Side::BUY, 100.0, 7));
-    ob.AddOrder(NewOrderPtr(11, Side::BUY, 100.0, 3));
+    ob.AddOrder(NewOrder(10, Side::BUY, Price{ 10000 }, 7));
+    ob.AddOrder(NewOrder(11, Side::BUY, Price{ 10000 }, 3));
 
     Order *best_order = ob.GetBestOrder(Side::BUY);
     ASSERT_NE(best_order, nullptr);
@@ -58,16 +66,452 @@ TEST(OrderbookFIFO, SamePriceMaintainsFIFO)
 TEST(OrderbookSnapshot, SnapshotTopDepth) 
 {
     Orderbook ob;
-    ob.AddOrder(NewOrderPtr(1, Side::BUY, 110.0, 2));
-    ob.AddOrder(NewOrderPtr(2, Side::BUY, 109.0, 4));
-    ob.AddOrder(NewOrderPtr(3, Side::SELL, 120.0, 1));
-    ob.AddOrder(NewOrderPtr(4, Side::SELL, 121.0, 5));
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 11000 }, 2));
+    ob.AddOrder(NewOrder(2, Side::BUY, Price{ 10900 }, 4));
+    ob.AddOrder(NewOrder(3, Side::SELL, Price{ 12000 }, 1));
+    ob.AddOrder(NewOrder(4, Side::SELL, Price{ 12100 }, 5));
 
     auto snap = ob.SnapshotTop(2);
 
     EXPECT_EQ(snap.bids.size(), 2u);
     EXPECT_EQ(snap.asks.size(), 2u);
 
-    EXPECT_DOUBLE_EQ(snap.bids[0].price, 110.0);
-    EXPECT_DOUBLE_EQ(snap.asks[0].price, 120.0);
+    EXPECT_EQ(snap.bids[0].price, Price{ 11000 });
+    EXPECT_EQ(snap.asks[0].price, Price{ 12000 });
+}
+
+TEST(LadderOrderbook, AddGetRemoveBestPrice)
+{
+    LadderOrderbook ob;
+
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 10100 }, 10));
+    ob.AddOrder(NewOrder(2, Side::BUY, Price{ 10050 }, 10));
+    ob.AddOrder(NewOrder(3, Side::SELL, Price{ 10200 }, 5));
+
+    ASSERT_TRUE(ob.BestBid().has_value());
+    EXPECT_EQ(*ob.BestBid(), Price{ 10100 });
+    ASSERT_TRUE(ob.BestAsk().has_value());
+    EXPECT_EQ(*ob.BestAsk(), Price{ 10200 });
+
+    ob.RemoveOrder(1);
+    ASSERT_TRUE(ob.BestBid().has_value());
+    EXPECT_EQ(*ob.BestBid(), Price{ 10050 });
+
+    ob.RemoveOrder(2);
+    EXPECT_FALSE(ob.HasBids());
+    EXPECT_FALSE(ob.BestBid().has_value());
+    EXPECT_EQ(ob.GetBestOrder(Side::BUY), nullptr);
+}
+
+TEST(LadderOrderbook, SamePriceMaintainsFIFO)
+{
+    LadderOrderbook ob;
+
+    ob.AddOrder(NewOrder(10, Side::SELL, Price{ 10000 }, 7));
+    ob.AddOrder(NewOrder(11, Side::SELL, Price{ 10000 }, 3));
+
+    Order *best_order = ob.GetBestOrder(Side::SELL);
+    ASSERT_NE(best_order, nullptr);
+    EXPECT_EQ(best_order->id, 10);
+
+    ob.RemoveOrder(10);
+    best_order = ob.GetBestOrder(Side::SELL);
+    ASSERT_NE(best_order, nullptr);
+    EXPECT_EQ(best_order->id, 11);
+    EXPECT_EQ(ob.GetOrder(10), nullptr);
+}
+
+TEST(LadderOrderbook, RecentresWhenPriceDrifts)
+{
+    LadderOrderbook ob(64);
+
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 10000 }, 1));
+    ob.AddOrder(NewOrder(2, Side::SELL, Price{ 10005 }, 2));
+    ob.RemoveOrder(1);
+
+    ob.AddOrder(NewOrder(3, Side::SELL, Price{ 10035 }, 3));
+    ob.AddOrder(NewOrder(4, Side::BUY, Price{ 10001 }, 4));
+
+    EXPECT_EQ(ob.WindowTicks(), 64u);
+    EXPECT_EQ(*ob.BestBid(), Price{ 10001 });
+    EXPECT_EQ(*ob.BestAsk(), Price{ 10005 });
+
+    ob.RemoveOrder(2);
+    EXPECT_EQ(*ob.BestAsk(), Price{ 10035 });
+    EXPECT_EQ(ob.GetOrder(3)->quantity, 3u);
+    EXPECT_EQ(ob.GetBestOrder(Side::BUY)->id, 4u);
+}
+
+TEST(LadderOrderbook, GrowsWhenSpanExceedsWindow)
+{
+    LadderOrderbook ob(16);
+
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 5000 }, 1));
+    ob.AddOrder(NewOrder(2, Side::SELL, Price{ 15000 }, 1));
+
+    EXPECT_GE(ob.WindowTicks(), 10001u);
+    EXPECT_EQ(*ob.BestBid(), Price{ 5000 });
+    EXPECT_EQ(*ob.BestAsk(), Price{ 15000 });
+
+    ob.RemoveOrder(2);
+    EXPECT_FALSE(ob.HasAsks());
+    EXPECT_EQ(ob.GetBestOrder(Side::BUY)->id, 1u);
+}
+
+TEST(LadderOrderbook, RejectsPriceBeyondMaxWindow)
+{
+    LadderOrderbook ob(16, 64, 4096);
+
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 10000 }, 1));
+    EXPECT_EQ(ob.AddOrder(NewOrder(2, Side::SELL, Price{ 10000 + (1u << 24) }, 1)), nullptr);
+    EXPECT_EQ(ob.AddOrder(NewOrder(3, Side::SELL, Price{ 0xFFFFFFF0u }, 1)), nullptr);
+    EXPECT_EQ(ob.OutOfRangeCount(), 2u);
+    EXPECT_LE(ob.WindowTicks(), 4096u);
+    EXPECT_FALSE(ob.HasAsks());
+    EXPECT_EQ(ob.GetOrder(2), nullptr);
+
+    // Still grows up to the cap for prices that fit.
+    ASSERT_NE(ob.AddOrder(NewOrder(4, Side::SELL, Price{ 13000 }, 1)), nullptr);
+    EXPECT_EQ(ob.WindowTicks(), 4096u);
+    EXPECT_EQ(*ob.BestAsk(), Price{ 13000 });
+
+    // A modify out of range leaves the order where it was.
+    EXPECT_FALSE(ob.ModifyOrder(1, Price{ 1u << 30 }, 1));
+    EXPECT_EQ(*ob.BestBid(), Price{ 10000 });
+    EXPECT_EQ(ob.GetBestOrder(Side::BUY)->id, 1u);
+
+    ob.RemoveOrder(1);
+    ob.RemoveOrder(4);
+    ASSERT_NE(ob.AddOrder(NewOrder(5, Side::SELL, Price{ 1u << 30 }, 1)), nullptr);
+    EXPECT_EQ(*ob.BestAsk(), Price{ 1u << 30 });
+}
+
+TEST(LadderOrderbook, SnapshotTopDepth)
+{
+    LadderOrderbook ob;
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 11000 }, 2));
+    ob.AddOrder(NewOrder(2, Side::BUY, Price{ 10900 }, 4));
+    ob.AddOrder(NewOrder(3, Side::BUY, Price{ 10900 }, 1));
+    ob.AddOrder(NewOrder(4, Side::BUY, Price{ 10800 }, 1));
+    ob.AddOrder(NewOrder(5, Side::SELL, Price{ 12000 }, 1));
+    ob.AddOrder(NewOrder(6, Side::SELL, Price{ 12100 }, 5));
+
+    auto snap = ob.SnapshotTop(2);
+
+    ASSERT_EQ(snap.bids.size(), 2u);
+    ASSERT_EQ(snap.asks.size(), 2u);
+
+    EXPECT_EQ(snap.bids[0].price, Price{ 11000 });
+    EXPECT_EQ(snap.bids[1].price, Price{ 10900 });
+    EXPECT_EQ(snap.bids[1].quantity, 5u);
+    EXPECT_EQ(snap.bids[1].orders, 2u);
+    EXPECT_EQ(snap.asks[0].price, Price{ 12000 });
+    EXPECT_EQ(snap.asks[1].price, Price{ 12100 });
+}
+
+TEST(OrderPool, QueueIsFIFOAndHandlesAreReused)
+{
+    OrderPool pool(64);
+    OrderQueue queue;
+
+    OrderHandle a = pool.Acquire(NewOrder(1, Side::BUY, Price{ 1000 }, 1));
+    OrderHandle b = pool.Acquire(NewOrder(2, Side::BUY, Price{ 1000 }, 1));
+    OrderHandle c = pool.Acquire(NewOrder(3, Side::BUY, Price{ 1000 }, 1));
+    queue.PushBack(pool, a);
+    queue.PushBack(pool, b);
+    queue.PushBack(pool, c);
+
+    queue.Erase(pool, b);
+    pool.Release(b);
+    EXPECT_EQ(queue.Size(), 2u);
+    EXPECT_EQ(pool.Get(queue.Front()).id, 1u);
+    EXPECT_EQ(pool.Get(pool.Next(queue.Front())).id, 3u);
+
+    OrderHandle d = pool.Acquire(NewOrder(4, Side::BUY, Price{ 1000 }, 1));
+    EXPECT_EQ(d, b);
+
+    queue.Erase(pool, a);
+    queue.Erase(pool, c);
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_EQ(queue.Front(), InvalidOrderHandle);
+}
+
+TEST(OrderPool, GrowthKeepsOrdersInPlace)
+{
+    OrderPool pool(64);
+    OrderHandle first = pool.Acquire(NewOrder(1, Side::SELL, Price{ 1000 }, 1));
+    Order *first_ptr = &pool.Get(first);
+
+    for (OrderId id = 2; id <= 100; ++id)
+    {
+        (void)pool.Acquire(NewOrder(id, Side::SELL, Price{ 1000 }, 1));
+    }
+
+    EXPECT_EQ(pool.Size(), 100u);
+    EXPECT_EQ(pool.Capacity(), 128u);
+    EXPECT_EQ(&pool.Get(first), first_ptr);
+    EXPECT_EQ(first_ptr->id, 1u);
+}
+
+TEST(OrderPool, AcquireReleaseDoesNotAllocate)
+{
+    OrderPool pool(1024);
+    OrderQueue queue;
+    std::vector<OrderHandle> handles;
+    handles.reserve(1024);
+
+    size_t before = AllocationCount();
+    for (int round = 0; round < 8; ++round)
+    {
+        for (OrderId id = 0; id < 1024; ++id)
+        {
+            handles.push_back(pool.Acquire(NewOrder(id, Side::BUY, Price{ 1000 }, 1)));
+            queue.PushBack(pool, handles.back());
+        }
+        for (OrderHandle handle : handles)
+        {
+            queue.Erase(pool, handle);
+            pool.Release(handle);
+        }
+        handles.clear();
+    }
+
+    EXPECT_EQ(AllocationCount() - before, 0u);
+}
+
+TEST(LadderOrderbook, AddCancelFillAllocationCount)
+{
+    constexpr OrderId N = 512;
+    LadderOrderbook ob(1024, N);
+
+    auto churn = [&ob]()
+        {
+            for (OrderId id = 1; id <= N; ++id)
+            {
+                Side side = (id % 2) ? Side::BUY : Side::SELL;
+                Price price = (side == Side::BUY) ? Price{ 9900 } - (id % 16) : Price{ 10100 } + (id % 16);
+                ob.AddOrder(NewOrder(id, side, price, 10));
+            }
+            for (OrderId id = 1; id <= N; ++id)
+            {
+                if (id % 3 == 0)
+                {
+                    ob.GetOrder(id)->filled_qty += 10;  // fill, then retire from the book
+                }
+                ob.RemoveOrder(id);
+            }
+        };
+
+    churn();
+
+    size_t before = AllocationCount();
+    churn();
+    size_t allocations = AllocationCount() - before;
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_FALSE(ob.HasBids());
+    EXPECT_FALSE(ob.HasAsks());
+}
+
+TEST(LevelBitmap, NextPrevAcrossLevels)
+{
+    LevelBitmap bits(300000);
+    EXPECT_FALSE(bits.Any());
+    EXPECT_EQ(bits.First(), LevelBitmap::npos);
+    EXPECT_EQ(bits.Last(), LevelBitmap::npos);
+
+    bits.Set(5);
+    bits.Set(70000);
+    bits.Set(299999);
+
+    EXPECT_EQ(bits.First(), 5u);
+    EXPECT_EQ(bits.Last(), 299999u);
+    EXPECT_EQ(bits.FindNext(6), 70000u);
+    EXPECT_EQ(bits.FindNext(70001), 299999u);
+    EXPECT_EQ(bits.FindPrev(299998), 70000u);
+    EXPECT_EQ(bits.FindPrev(69999), 5u);
+    EXPECT_EQ(bits.FindPrev(4), LevelBitmap::npos);
+
+    bits.Clear(70000);
+    EXPECT_EQ(bits.FindNext(6), 299999u);
+    EXPECT_EQ(bits.FindPrev(299998), 5u);
+}
+
+TEST(LevelBitmap, MatchesOrderedSet)
+{
+    constexpr size_t N = 5000;
+    LevelBitmap bits(N);
+    std::set<size_t> reference;
+    std::mt19937 rng(42);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        size_t pos = rng() % N;
+        if (rng() % 2) { bits.Set(pos); reference.insert(pos); }
+        else { bits.Clear(pos); reference.erase(pos); }
+
+        size_t probe = rng() % N;
+        auto next = reference.lower_bound(probe);
+        EXPECT_EQ(bits.FindNext(probe), next == reference.end() ? LevelBitmap::npos : *next);
+
+        auto prev = reference.upper_bound(probe);
+        EXPECT_EQ(bits.FindPrev(probe), prev == reference.begin() ? LevelBitmap::npos : *std::prev(prev));
+    }
+}
+
+TEST(LadderOrderbook, SparseBookWalksOccupiedLevelsOnly)
+{
+    LadderOrderbook ob(8192);
+
+    // 50 asks spread over 5000 ticks, 100 ticks apart.
+    for (OrderId id = 1; id <= 50; ++id)
+    {
+        ob.AddOrder(NewOrder(id, Side::SELL, Price{ 10000 } + static_cast<int64_t>(id) * 100, 1));
+    }
+    ob.AddOrder(NewOrder(100, Side::BUY, Price{ 6000 }, 1));
+    ob.AddOrder(NewOrder(101, Side::BUY, Price{ 4000 }, 1));
+
+    for (OrderId id = 1; id <= 50; ++id)
+    {
+        ASSERT_TRUE(ob.BestAsk().has_value());
+        EXPECT_EQ(*ob.BestAsk(), Price{ 10000 } + static_cast<int64_t>(id) * 100);
+        EXPECT_EQ(ob.GetBestOrder(Side::SELL)->id, id);
+        ob.RemoveOrder(id);
+    }
+    EXPECT_FALSE(ob.HasAsks());
+
+    ob.RemoveOrder(100);
+    EXPECT_EQ(*ob.BestBid(), Price{ 4000 });
+
+    auto snap = ob.SnapshotTop(5);
+    ASSERT_EQ(snap.bids.size(), 1u);
+    EXPECT_TRUE(snap.asks.empty());
+}
+
+TEST(BookManager, RoutesByDenseSymbolId)
+{
+    const std::vector<SymbolReference> symbols = {
+        { 7, 4096, 1024 },
+        { 2 },
+        { 3 },
+    };
+
+    BookManager<LadderOrderbook> books(symbols);
+    ASSERT_EQ(books.Size(), 3u);
+    EXPECT_EQ(books.SymbolAt(0), 7u);
+
+    ASSERT_NE(books.Find(7), nullptr);
+    ASSERT_NE(books.Find(2), nullptr);
+    EXPECT_EQ(books.Find(0), nullptr);
+    EXPECT_EQ(books.Find(8), nullptr);
+    EXPECT_EQ(books.Find(1u << 31), nullptr);
+
+    books.Find(7)->AddOrder(NewOrder(1, Side::BUY, Price{ 10000 }, 5));
+    books.Find(2)->AddOrder(NewOrder(2, Side::SELL, Price{ 10000 }, 5));
+
+    EXPECT_TRUE(books.Find(7)->HasBids());
+    EXPECT_FALSE(books.Find(7)->HasAsks());
+    EXPECT_TRUE(books.Find(2)->HasAsks());
+    EXPECT_FALSE(books.Find(3)->HasBids());
+    EXPECT_EQ(books.Find(2)->GetOrder(1), nullptr);
+}
+
+TEST(BookManager, WorksWithMapBook)
+{
+    const std::vector<SymbolReference> symbols = { { 0 }, { 1 } };
+    BookManager<Orderbook> books(symbols);
+
+    books.Find(1)->AddOrder(NewOrder(1, Side::BUY, Price{ 500 }, 5));
+    EXPECT_FALSE(books.Find(0)->HasBids());
+    EXPECT_EQ(*books.Find(1)->BestBid(), Price{ 500 });
+}
+
+TEST(BookManager, RejectsDuplicateSymbols)
+{
+    const std::vector<SymbolReference> symbols = { { 4 }, { 4 } };
+    EXPECT_THROW(BookManager<Orderbook> books(symbols), std::invalid_argument);
+}
+
+template <typename Book>
+static void ExpectLevelAggregates(Book &ob)
+{
+    ob.AddOrder(NewOrder(1, Side::SELL, Price{ 10000 }, 5));
+    ob.AddOrder(NewOrder(2, Side::SELL, Price{ 10000 }, 5));
+    ob.AddOrder(NewOrder(3, Side::SELL, Price{ 10002 }, 7));
+    ob.AddOrder(NewOrder(4, Side::BUY, Price{ 9990 }, 4));
+
+    EXPECT_EQ(ob.AvailableQuantity(Side::SELL, Price{ 10001 }, 100), 10u);
+    EXPECT_EQ(ob.AvailableQuantity(Side::SELL, Price{ 10002 }, 100), 17u);
+    EXPECT_EQ(ob.AvailableQuantity(Side::SELL, std::nullopt, 100), 17u);
+    EXPECT_EQ(ob.AvailableQuantity(Side::SELL, std::nullopt, 3), 10u);
+    EXPECT_EQ(ob.AvailableQuantity(Side::BUY, Price{ 9991 }, 100), 0u);
+    EXPECT_EQ(ob.AvailableQuantity(Side::BUY, Price{ 9990 }, 100), 4u);
+
+    ob.FillBestOrder(Side::SELL, 3);
+    EXPECT_EQ(ob.SnapshotTop(1).asks[0].quantity, 7u);
+    EXPECT_EQ(ob.GetOrder(1)->RemainingQuantity(), 2u);
+
+    ob.FillBestOrder(Side::SELL, 2);
+    EXPECT_EQ(ob.GetOrder(1), nullptr);
+    EXPECT_EQ(ob.SnapshotTop(1).asks[0].quantity, 5u);
+    EXPECT_EQ(ob.AvailableQuantity(Side::SELL, Price{ 10002 }, 100), 12u);
+}
+
+TEST(OrderbookLiquidity, AvailableQuantityAndPartialFills)
+{
+    Orderbook ob;
+    ExpectLevelAggregates(ob);
+}
+
+TEST(LadderOrderbook, AvailableQuantityAndPartialFills)
+{
+    LadderOrderbook ob(64);
+    ExpectLevelAggregates(ob);
+}
+
+template <typename Book>
+static void ExpectModifySemantics(Book &ob)
+{
+    ob.AddOrder(NewOrder(1, Side::BUY, Price{ 10000 }, 10));
+    ob.AddOrder(NewOrder(2, Side::BUY, Price{ 10000 }, 10));
+    Order *first = ob.GetOrder(1);
+
+    // Size down in place: same node, same queue position.
+    EXPECT_TRUE(ob.ModifyOrder(1, Price{ 10000 }, 4));
+    EXPECT_EQ(ob.GetOrder(1), first);
+    EXPECT_EQ(ob.GetBestOrder(Side::BUY)->id, 1u);
+    EXPECT_EQ(ob.SnapshotTop(1).bids[0].quantity, 14u);
+
+    // Size up loses priority.
+    EXPECT_TRUE(ob.ModifyOrder(1, Price{ 10000 }, 6));
+    EXPECT_EQ(ob.GetBestOrder(Side::BUY)->id, 2u);
+    EXPECT_EQ(ob.SnapshotTop(1).bids[0].quantity, 16u);
+
+    // Price change moves the same node to the new level.
+    EXPECT_TRUE(ob.ModifyOrder(1, Price{ 10005 }, 6));
+    EXPECT_EQ(ob.GetOrder(1), first);
+    EXPECT_EQ(ob.BestBid(), Price{ 10005 });
+    auto snap = ob.SnapshotTop(2);
+    ASSERT_EQ(snap.bids.size(), 2u);
+    EXPECT_EQ(snap.bids[0].quantity, 6u);
+    EXPECT_EQ(snap.bids[1].quantity, 10u);
+
+    // Shrinking to the filled amount retires the order.
+    ob.GetOrder(2)->filled_qty = 3;
+    EXPECT_FALSE(ob.ModifyOrder(2, Price{ 10000 }, 3));
+    EXPECT_EQ(ob.GetOrder(2), nullptr);
+    EXPECT_EQ(ob.SnapshotTop(5).bids.size(), 1u);
+    EXPECT_FALSE(ob.ModifyOrder(42, Price{ 10000 }, 1));
+}
+
+TEST(OrderbookModify, InPlaceAndMoveBetweenLevels)
+{
+    Orderbook ob;
+    ExpectModifySemantics(ob);
+}
+
+TEST(LadderOrderbook, ModifyInPlaceAndMoveBetweenLevels)
+{
+    LadderOrderbook ob(64);
+    ExpectModifySemantics(ob);
 }
@@ -1,19 +1,38 @@
 #include <benchmark/benchmark.h>
-#include <windows.h>
 #include <stdexcept>
 #include <thread>
 #include <iostream>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <span>
+#include <chrono>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "ring_buffer/ring_buffer.h"
 
 using namespace hft;
 
+// CPU ids wrap at the machine's core count, so the same binary still runs
+// (unpinned in effect) on a box with fewer cores than the defaults below.
 static void PinThread(int cpu) 
 {
     if (cpu < 0) 
     {
         return;
     }
+    cpu %= static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+#if defined(_WIN32)
     HANDLE thread_handle = GetCurrentThread();
 
     DWORD_PTR mask = 1ull << cpu;
@@ -24,7 +43,355 @@ static void PinThread(int cpu)
             << GetLastError() << std::endl;
         std::exit(EXIT_FAILURE);
     }
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    if (int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); rc != 0)
+    {
+        std::cerr << "pthread_setaffinity_np failed with error "
+            << rc << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+#endif
 }
 
 constexpr auto cpu1 = 0;
 constexpr auto cpu2 = 1;
+
+// Element sizes swept by the SPSC suite: a bare word, one cache line, and
+// the logger's 320-byte cache-line-aligned LogEntry.
+template <size_t Bytes, size_t Align = alignof(std::max_align_t)>
+struct alignas(Align) Payload
+{
+    std::array<std::byte, Bytes> data;
+};
+
+using Word = Payload<8, 8>;
+using CacheLine = Payload<64, 64>;
+using LogEntrySized = Payload<320, 64>;
+
+// Log-linear latency histogram: each power-of-two range of nanoseconds is
+// split into 16 linear sub-buckets, so percentiles are within ~6% without
+// keeping every sample.
+class LatencyHistogram
+{
+public:
+    void Record(uint64_t ns) noexcept
+    {
+        ++m_buckets[BucketOf(ns)];
+        ++m_count;
+        m_max = std::max(m_max, ns);
+    }
+
+    // Upper edge of the bucket holding the p-th percentile sample.
+    uint64_t Percentile(double p) const noexcept
+    {
+        if (m_count == 0) { return 0; }
+        const uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(m_count - 1)) + 1;
+
+        uint64_t seen = 0;
+        for (size_t b = 0; b < Buckets; ++b)
+        {
+            seen += m_buckets[b];
+            if (seen >= rank) { return std::min(UpperEdge(b), m_max); }
+        }
+        return m_max;
+    }
+
+    void Report(benchmark::State &state) const
+    {
+        state.counters["p50_ns"] = static_cast<double>(Percentile(0.50));
+        state.counters["p90_ns"] = static_cast<double>(Percentile(0.90));
+        state.counters["p99_ns"] = static_cast<double>(Percentile(0.99));
+        state.counters["p999_ns"] = static_cast<double>(Percentile(0.999));
+        state.counters["max_ns"] = static_cast<double>(m_max);
+    }
+
+private:
+    static constexpr size_t SubBits = 4;
+    static constexpr size_t SubBuckets = size_t{ 1 } << SubBits;
+    static constexpr size_t Buckets = 64 * SubBuckets;
+
+    std::array<uint64_t, Buckets> m_buckets{ };
+    uint64_t m_count{ 0 };
+    uint64_t m_max{ 0 };
+
+    static size_t BucketOf(uint64_t ns) noexcept
+    {
+        if (ns < SubBuckets) { return static_cast<size_t>(ns); }
+        const size_t exponent = static_cast<size_t>(std::bit_width(ns)) - 1 - SubBits;
+        const size_t sub = static_cast<size_t>(ns >> exponent) & (SubBuckets - 1);
+        return (exponent + 1) * SubBuckets + sub;
+    }
+
+    static uint64_t UpperEdge(size_t bucket) noexcept
+    {
+        if (bucket < SubBuckets) { return bucket; }
+        const size_t exponent = bucket / SubBuckets - 1;
+        const uint64_t sub = bucket % SubBuckets;
+        return ((SubBuckets + sub + 1) << exponent) - 1;
+    }
+};
+
+static int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+// Items moved from P producers to C consumers through one MPMC ring.
+// Reported rate is items per second across all threads.
+static void BM_MPMCThroughput(benchmark::State &state)
+{
+    const int producers = static_cast<int>(state.range(0));
+    const int consumers = static_cast<int>(state.range(1));
+    constexpr uint64_t ItemsPerRun = 1 << 18;
+
+    for (auto _ : state)
+    {
+        MPMCRingBuffer<uint64_t, 4096> rb;
+        std::atomic<uint64_t> consumed{ 0 };
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < producers; ++p)
+        {
+            const uint64_t share = ItemsPerRun / producers + (p < static_cast<int>(ItemsPerRun % producers) ? 1 : 0);
+            threads.emplace_back([&rb, share]()
+                {
+                    for (uint64_t i = 0; i < share; ++i)
+                    {
+                        while (!rb.TryPush(i)) { }
+                    }
+                });
+        }
+
+        for (int c = 0; c < consumers; ++c)
+        {
+            threads.emplace_back([&rb, &consumed]()
+                {
+                    uint64_t value;
+                    while (consumed.load(std::memory_order_relaxed) < ItemsPerRun)
+                    {
+                        if (rb.TryPop(value))
+                        {
+                            benchmark::DoNotOptimize(value);
+                            consumed.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                });
+        }
+
+        for (auto &t : threads) { t.join(); }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ItemsPerRun));
+}
+BENCHMARK(BM_MPMCThroughput)
+    ->ArgsProduct({ { 1, 2, 4 }, { 1, 2, 4 } })
+    ->ArgNames({ "producers", "consumers" })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Push+pop pair per iteration with every benchmark thread hitting the same
+// ring, so the time per iteration is the contended operation latency.
+static void BM_MPMCPushPopContended(benchmark::State &state)
+{
+    static MPMCRingBuffer<uint64_t, 1024> rb;
+    uint64_t value = 0;
+
+    for (auto _ : state)
+    {
+        while (!rb.TryPush(value)) { }
+        while (!rb.TryPop(value)) { }
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_MPMCPushPopContended)->ThreadRange(1, 8);
+
+// Ping-pong between two pinned threads over a pair of MPMC rings; half the
+// round trip is the one-way handoff latency.
+static void BM_MPMCRoundTrip(benchmark::State &state)
+{
+    MPMCRingBuffer<uint64_t, 1024> ping;
+    MPMCRingBuffer<uint64_t, 1024> pong;
+    std::atomic<bool> done{ false };
+
+    std::thread echo([&]()
+        {
+            PinThread(cpu2);
+            uint64_t value;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                if (ping.TryPop(value))
+                {
+                    while (!pong.TryPush(value)) { }
+                }
+            }
+        });
+
+    PinThread(cpu1);
+    uint64_t value = 0;
+    for (auto _ : state)
+    {
+        while (!ping.TryPush(value)) { }
+        while (!pong.TryPop(value)) { }
+        ++value;
+    }
+
+    done.store(true, std::memory_order_relaxed);
+    echo.join();
+}
+BENCHMARK(BM_MPMCRoundTrip);
+
+// SPSC transfer with one element per call (batch 1) versus TryPushN/PopN
+// batches; larger batches publish each index once per batch.
+static void BM_SPSCBatchThroughput(benchmark::State &state)
+{
+    const size_t batch = static_cast<size_t>(state.range(0));
+    constexpr uint64_t ItemsPerRun = 1 << 20;
+
+    for (auto _ : state)
+    {
+        SPSCRingBuffer<uint64_t, 4096> rb;
+
+        std::thread consumer([&rb, batch]()
+            {
+                PinThread(cpu2);
+                uint64_t received = 0;
+                while (received < ItemsPerRun)
+                {
+                    received += rb.PopN([](uint64_t &value) { benchmark::DoNotOptimize(value); }, batch);
+                }
+            });
+
+        PinThread(cpu1);
+        std::vector<uint64_t> items(batch);
+        for (uint64_t sent = 0; sent < ItemsPerRun; )
+        {
+            const size_t n = static_cast<size_t>(std::min<uint64_t>(batch, ItemsPerRun - sent));
+            sent += rb.TryPushN(std::span<const uint64_t>(items.data(), n));
+        }
+
+        consumer.join();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ItemsPerRun));
+}
+BENCHMARK(BM_SPSCBatchThroughput)->RangeMultiplier(4)->Range(1, 256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Uncontended cost of one push followed by one pop on the same thread:
+// the floor every cross-thread number below is measured against.
+template <typename T, size_t Capacity>
+static void BM_SPSCPushPop(benchmark::State &state)
+{
+    SPSCRingBuffer<T, Capacity> rb;
+    T value{ };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(rb.TryPush(value));
+        value = *rb.Peek();
+        benchmark::DoNotOptimize(rb.TryPop());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(T)));
+}
+BENCHMARK_TEMPLATE(BM_SPSCPushPop, Word, 1024);
+BENCHMARK_TEMPLATE(BM_SPSCPushPop, CacheLine, 1024);
+BENCHMARK_TEMPLATE(BM_SPSCPushPop, LogEntrySized, 1024);
+
+// One item per call between two pinned threads, swept over capacity and
+// element size. Small rings stress the full/empty index reloads, large
+// ones the cache footprint of the slots.
+template <typename T, size_t Capacity>
+static void BM_SPSCThroughput(benchmark::State &state)
+{
+    constexpr uint64_t ItemsPerRun = 1 << 18;
+
+    for (auto _ : state)
+    {
+        SPSCRingBuffer<T, Capacity> rb;
+
+        std::thread consumer([&rb]()
+            {
+                PinThread(cpu2);
+                uint64_t received = 0;
+                while (received < ItemsPerRun)
+                {
+                    if (T *item = rb.Peek())
+                    {
+                        benchmark::DoNotOptimize(item->data[0]);
+                        (void)rb.TryPop();
+                        ++received;
+                    }
+                }
+            });
+
+        PinThread(cpu1);
+        const T item{ };
+        for (uint64_t sent = 0; sent < ItemsPerRun; ++sent)
+        {
+            while (!rb.TryPush(item)) { }
+        }
+
+        consumer.join();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ItemsPerRun));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * ItemsPerRun * sizeof(T)));
+}
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, Word, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, Word, 1024)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, Word, 65536)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, CacheLine, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, CacheLine, 1024)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, CacheLine, 65536)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, LogEntrySized, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SPSCThroughput, LogEntrySized, 1024)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Ping-pong between two pinned threads over a pair of SPSC rings. Every
+// round trip is timed into a histogram, so the tail shows up next to the
+// mean; half the round trip is the one-way handoff latency.
+template <typename T, size_t Capacity>
+static void BM_SPSCRoundTrip(benchmark::State &state)
+{
+    SPSCRingBuffer<T, Capacity> ping;
+    SPSCRingBuffer<T, Capacity> pong;
+    std::atomic<bool> done{ false };
+
+    std::thread echo([&]()
+        {
+            PinThread(cpu2);
+            while (!done.load(std::memory_order_relaxed))
+            {
+                if (T *item = ping.Peek())
+                {
+                    while (!pong.TryPush(*item)) { }
+                    (void)ping.TryPop();
+                }
+            }
+        });
+
+    PinThread(cpu1);
+    LatencyHistogram histogram;
+    const T item{ };
+    for (auto _ : state)
+    {
+        const int64_t start = NowNs();
+        while (!ping.TryPush(item)) { }
+        while (!pong.Peek()) { }
+        (void)pong.TryPop();
+        histogram.Record(static_cast<uint64_t>(NowNs() - start));
+    }
+
+    done.store(true, std::memory_order_relaxed);
+    echo.join();
+    histogram.Report(state);
+}
+BENCHMARK_TEMPLATE(BM_SPSCRoundTrip, Word, 1024);
+BENCHMARK_TEMPLATE(BM_SPSCRoundTrip, CacheLine, 1024);
+BENCHMARK_TEMPLATE(BM_SPSCRoundTrip, LogEntrySized, 1024);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "ring_buffer/shm_ring_buffer.h"
+#include "ring_buffer/wait_strategy.h"
+
+using namespace hft;
+
+namespace
+{
+    using Ring = ShmSPSCRingBuffer<int64_t, 1024>;
+    constexpr int64_t StopToken = -1;
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Child process: echo every item from `ping` back on `pong` until told
+    // to stop.
+    [[noreturn]] void RunEcho(const std::string &ping_name, const std::string &pong_name)
+    {
+        auto ping = Ring::Attach(ping_name, ShmRole::Consumer);
+        auto pong = Ring::Attach(pong_name, ShmRole::Producer);
+
+        for (;;)
+        {
+            int64_t value = 0;
+            while (!ping.TryPop(value)) { CpuRelax(); }
+            if (value == StopToken) { ::_exit(0); }
+            while (!pong.TryPush(value)) { CpuRelax(); }
+        }
+    }
+}
+
+// Round trip between two processes on one host: the parent stamps a
+// message into one shared ring, a forked child echoes it back on a
+// second. Both sides busy-spin, so pin them to different cores (taskset)
+// for meaningful numbers. Reported time is per round trip.
+static void BM_ShmRoundTrip(benchmark::State &state)
+{
+    const std::string suffix = std::to_string(::getpid());
+    const std::string ping_name = "hft_bench_ping_" + suffix;
+    const std::string pong_name = "hft_bench_pong_" + suffix;
+    Ring::Unlink(ping_name);
+    Ring::Unlink(pong_name);
+
+    auto ping = Ring::Create(ping_name, ShmRole::Producer);
+    auto pong = Ring::Create(pong_name, ShmRole::Consumer);
+
+    const pid_t child = ::fork();
+    if (child < 0)
+    {
+        state.SkipWithError("fork failed");
+        return;
+    }
+    if (child == 0) { RunEcho(ping_name, pong_name); }
+
+    std::vector<int64_t> samples;
+    samples.reserve(1 << 20);
+
+    for (auto _ : state)
+    {
+        const int64_t sent = NowNs();
+        while (!ping.TryPush(sent)) { CpuRelax(); }
+
+        int64_t echoed = 0;
+        while (!pong.TryPop(echoed)) { CpuRelax(); }
+        if (samples.size() < samples.capacity()) { samples.push_back(NowNs() - echoed); }
+    }
+
+    while (!ping.TryPush(StopToken)) { CpuRelax(); }
+    ::waitpid(child, nullptr, 0);
+    Ring::Unlink(ping_name);
+    Ring::Unlink(pong_name);
+
+    if (!samples.empty())
+    {
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](double p)
+            {
+                return static_cast<double>(samples[static_cast<size_t>(p * static_cast<double>(samples.size() - 1))]);
+            };
+        state.counters["p50_ns"] = percentile(0.50);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+    }
+}
+BENCHMARK(BM_ShmRoundTrip)->UseRealTime();
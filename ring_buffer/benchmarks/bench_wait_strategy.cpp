@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+
+#include "ring_buffer/ring_buffer.h"
+#include "ring_buffer/wait_strategy.h"
+
+using namespace hft;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+}
+
+// Wake-up latency against CPU burn at low load. A producer sends one
+// timestamp every `gap` microseconds; the consumer idles with the chosen
+// strategy between messages. wake_ns is publish-to-receive latency,
+// cpu_util is process CPU time over wall time (the producer mostly sleeps,
+// so this is dominated by the waiting consumer).
+static void BM_WaitStrategyWakeup(benchmark::State &state)
+{
+    WaitConfig config;
+    config.mode = static_cast<WaitMode>(state.range(0));
+    const auto gap = std::chrono::microseconds(state.range(1));
+    constexpr int MessagesPerRun = 200;
+
+    int64_t total_latency = 0;
+    int64_t messages = 0;
+    double cpu_seconds = 0;
+    double wall_seconds = 0;
+
+    for (auto _ : state)
+    {
+        SPSCRingBuffer<int64_t, 64> rb;
+        WaitSignal signal;
+        std::atomic<bool> done{ false };
+
+        const std::clock_t cpu_start = std::clock();
+        const auto wall_start = Clock::now();
+
+        std::thread consumer([&]()
+            {
+                IdleWaiter waiter(config, &signal);
+                int received = 0;
+                while (received < MessagesPerRun)
+                {
+                    size_t n = rb.PopN([&](int64_t &sent)
+                        {
+                            total_latency += NowNs() - sent;
+                        });
+                    if (n == 0) { waiter.Idle(); continue; }
+                    waiter.Reset();
+                    received += static_cast<int>(n);
+                }
+                done.store(true);
+            });
+
+        for (int i = 0; i < MessagesPerRun; ++i)
+        {
+            std::this_thread::sleep_for(gap);
+            while (!rb.TryPush(NowNs())) { }
+            if (config.mode == WaitMode::SpinPark) { signal.Notify(); }
+        }
+
+        consumer.join();
+        messages += MessagesPerRun;
+        cpu_seconds += static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+        wall_seconds += std::chrono::duration<double>(Clock::now() - wall_start).count();
+    }
+
+    state.counters["wake_ns"] = static_cast<double>(total_latency) / static_cast<double>(messages);
+    state.counters["cpu_util"] = cpu_seconds / wall_seconds;
+}
+BENCHMARK(BM_WaitStrategyWakeup)
+    ->ArgNames({ "mode", "gap_us" })
+    ->ArgsProduct({ { static_cast<int64_t>(WaitMode::BusySpin),
+                      static_cast<int64_t>(WaitMode::SpinYield),
+                      static_cast<int64_t>(WaitMode::SpinPark),
+                      static_cast<int64_t>(WaitMode::TimedHybrid) },
+                    { 10, 100, 1000 } })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
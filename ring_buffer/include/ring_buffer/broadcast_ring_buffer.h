@@ -0,0 +1,241 @@
+#ifndef BROADCAST_RING_BUFFER_H
+#define BROADCAST_RING_BUFFER_H
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <span>
+#include <concepts>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include "ring_buffer/ring_buffer.h"
+
+namespace hft
+{
+    // Single producer, many consumers, every consumer sees every item.
+    // Each item is written once; every consumer keeps its own sequence over
+    // the same slots. The producer gates on the slowest consumer, and a
+    // consumer may depend on others so it only reads items they have already
+    // processed (e.g. drop-copy after the journal). Sequences are free-running
+    // item counts; only the slot index is masked.
+    //
+    // Consumers are registered with AddConsumer() before the producer and
+    // consumer threads start; the set is fixed after that.
+    template <typename T, size_t Capacity, typename Allocator = std::allocator<T>>
+        requires power_of_two<Capacity> && std::copyable<T> && std::default_initializable<T>
+    class BroadcastRingBuffer
+    {
+        using AllocTraits = std::allocator_traits<Allocator>;
+        static constexpr size_t CacheLineSize = std::hardware_destructive_interference_size;
+
+    public:
+        class Consumer
+        {
+        public:
+            Consumer(const Consumer &) = delete;
+            Consumer &operator=(const Consumer &) = delete;
+
+            // Hands up to `max` readable items to fn(const T&) in order and
+            // releases them with a single store. Returns the number consumed.
+            template <typename Fn>
+            size_t PopN(Fn &&fn, size_t max = Capacity)
+            {
+                const uint64_t read = m_sequence.load(std::memory_order_relaxed);
+                if (read == m_cached_limit)
+                {
+                    m_cached_limit = m_ring->ReadLimit(*this);
+                    if (read == m_cached_limit) { return 0; }
+                }
+
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(m_cached_limit - read, max));
+                for (size_t i = 0; i < count; ++i)
+                {
+                    fn(static_cast<const T &>(m_ring->m_data[(read + i) & (Capacity - 1)]));
+                }
+
+                m_sequence.store(read + count, std::memory_order_release);
+                return count;
+            }
+
+            [[nodiscard]] bool TryPop(T &out)
+            {
+                return PopN([&out](const T &item) { out = item; }, 1) == 1;
+            }
+
+            // Items published but not yet consumed by this consumer.
+            size_t Lag() const noexcept
+            {
+                return static_cast<size_t>(m_ring->m_published.load(std::memory_order_acquire)
+                                           - m_sequence.load(std::memory_order_acquire));
+            }
+
+            uint64_t Sequence() const noexcept { return m_sequence.load(std::memory_order_acquire); }
+
+        private:
+            friend class BroadcastRingBuffer;
+
+            Consumer(const BroadcastRingBuffer *ring, std::vector<const Consumer *> depends_on, uint64_t start)
+                : m_ring(ring)
+                , m_depends_on(std::move(depends_on))
+                , m_cached_limit(start)
+                , m_sequence(start)
+            { }
+
+            const BroadcastRingBuffer *m_ring;
+            std::vector<const Consumer *> m_depends_on;
+            uint64_t m_cached_limit;
+
+            alignas(CacheLineSize) std::atomic<uint64_t> m_sequence;
+        };
+
+        explicit BroadcastRingBuffer(const Allocator &alloc = Allocator())
+            : m_alloc(alloc)
+        {
+            m_data = AllocTraits::allocate(m_alloc, Capacity);
+            for (size_t i = 0; i < Capacity; ++i)
+            {
+                AllocTraits::construct(m_alloc, m_data + i);
+            }
+        }
+
+        ~BroadcastRingBuffer()
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+            {
+                AllocTraits::destroy(m_alloc, m_data + i);
+            }
+            AllocTraits::deallocate(m_alloc, m_data, Capacity);
+        }
+
+        BroadcastRingBuffer(const BroadcastRingBuffer &) = delete;
+        BroadcastRingBuffer &operator=(const BroadcastRingBuffer &) = delete;
+
+        BroadcastRingBuffer(BroadcastRingBuffer &&) = delete;
+        BroadcastRingBuffer &operator=(BroadcastRingBuffer &&) = delete;
+
+        // Registers a consumer that starts at the current publish position
+        // and only reads items every consumer in `depends_on` has released.
+        Consumer &AddConsumer(std::initializer_list<const Consumer *> depends_on = { })
+        {
+            for (const Consumer *dep : depends_on)
+            {
+                if (!dep || dep->m_ring != this)
+                {
+                    throw std::invalid_argument("Consumer dependency belongs to another ring");
+                }
+            }
+
+            const uint64_t start = m_published.load(std::memory_order_relaxed);
+            m_consumers.push_back(std::unique_ptr<Consumer>(new Consumer(this, depends_on, start)));
+            return *m_consumers.back();
+        }
+
+        [[nodiscard]] bool TryPush(const T &value) noexcept(std::is_nothrow_copy_assignable_v<T>)
+        {
+            T *slot = TryClaim();
+            if (!slot) { return false; }
+
+            *slot = value;
+            Commit();
+            return true;
+        }
+
+        // Copies as many leading items as fit and publishes them with one
+        // release store. Returns the number pushed.
+        size_t TryPushN(std::span<const T> items) noexcept(std::is_nothrow_copy_assignable_v<T>)
+        {
+            const uint64_t write = m_published.load(std::memory_order_relaxed);
+
+            size_t free = Capacity - static_cast<size_t>(write - m_cached_gate);
+            if (free < items.size())
+            {
+                m_cached_gate = MinConsumerSequence(write);
+                free = Capacity - static_cast<size_t>(write - m_cached_gate);
+            }
+
+            const size_t count = std::min(free, items.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_data[(write + i) & (Capacity - 1)] = items[i];
+            }
+
+            if (count > 0)
+            {
+                m_published.store(write + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        // Returns the next slot to fill in place, or nullptr while the
+        // slowest consumer still needs it. Nothing is visible until Commit().
+        [[nodiscard]] T *TryClaim() noexcept
+        {
+            const uint64_t write = m_published.load(std::memory_order_relaxed);
+            if (write - m_cached_gate == Capacity)
+            {
+                m_cached_gate = MinConsumerSequence(write);
+                if (write - m_cached_gate == Capacity) { return nullptr; }
+            }
+            return &m_data[write & (Capacity - 1)];
+        }
+
+        void Commit() noexcept
+        {
+            m_published.store(m_published.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // Items the slowest consumer has yet to release.
+        size_t Size() const noexcept
+        {
+            const uint64_t write = m_published.load(std::memory_order_acquire);
+            return static_cast<size_t>(write - MinConsumerSequence(write));
+        }
+
+        bool Empty() const noexcept { return Size() == 0; }
+        size_t GetCapacity() const noexcept { return Capacity; }
+        const Allocator &GetAllocator() const noexcept { return m_alloc; }
+        size_t ConsumerCount() const noexcept { return m_consumers.size(); }
+        uint64_t Published() const noexcept { return m_published.load(std::memory_order_acquire); }
+
+    private:
+        // With no consumers registered the producer never blocks.
+        uint64_t MinConsumerSequence(uint64_t write) const noexcept
+        {
+            uint64_t min = write;
+            for (const auto &consumer : m_consumers)
+            {
+                min = std::min(min, consumer->m_sequence.load(std::memory_order_acquire));
+            }
+            return min;
+        }
+
+        uint64_t ReadLimit(const Consumer &consumer) const noexcept
+        {
+            uint64_t limit = m_published.load(std::memory_order_acquire);
+            for (const Consumer *dep : consumer.m_depends_on)
+            {
+                limit = std::min(limit, dep->m_sequence.load(std::memory_order_acquire));
+            }
+            return limit;
+        }
+
+        alignas(CacheLineSize) std::atomic<uint64_t> m_published{ 0 };
+        alignas(CacheLineSize) uint64_t m_cached_gate{ 0 };
+        std::vector<std::unique_ptr<Consumer>> m_consumers;
+
+#ifdef _MSC_VER
+        Allocator m_alloc [[msvc::no_unique_address]];
+#else
+        Allocator m_alloc [[no_unique_address]];
+#endif
+        T *m_data;
+    };
+
+} // namespace hft
+
+#endif // BROADCAST_RING_BUFFER_H
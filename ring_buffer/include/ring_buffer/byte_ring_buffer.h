@@ -0,0 +1,216 @@
+#ifndef BYTE_RING_BUFFER_H
+#define BYTE_RING_BUFFER_H
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "ring_buffer/ring_buffer.h"
+
+namespace hft
+{
+    // SPSC ring of variable-size byte records. Each record is a 4-byte
+    // length followed by the payload, padded to 8 bytes, and always stored
+    // contiguously: when a record does not fit before the end of storage the
+    // producer writes a skip marker and starts the record at offset 0. The
+    // consumer gets std::span<const std::byte> views straight into the ring.
+    // Positions are free-running byte counters; only the offset is masked.
+    template <size_t Capacity, typename Allocator = std::allocator<std::byte>>
+        requires power_of_two<Capacity> && (Capacity >= 64)
+    class ByteRingBuffer
+    {
+        using AllocTraits = std::allocator_traits<Allocator>;
+        static constexpr size_t CacheLineSize = std::hardware_destructive_interference_size;
+        static constexpr size_t HeaderSize = sizeof(uint32_t);
+        static constexpr size_t RecordAlign = 8;
+        static constexpr uint32_t SkipMarker = UINT32_MAX;
+
+    public:
+        // Largest payload that can ever be claimed; anything bigger could
+        // need more than the whole ring once a skip is added.
+        static constexpr size_t MaxPayload = Capacity / 2 - HeaderSize;
+
+        explicit ByteRingBuffer(const Allocator &alloc = Allocator())
+            : m_alloc(alloc)
+        {
+            m_data = AllocTraits::allocate(m_alloc, Capacity);
+        }
+
+        ~ByteRingBuffer()
+        {
+            AllocTraits::deallocate(m_alloc, m_data, Capacity);
+        }
+
+        ByteRingBuffer(const ByteRingBuffer &) = delete;
+        ByteRingBuffer &operator=(const ByteRingBuffer &) = delete;
+
+        ByteRingBuffer(ByteRingBuffer &&) = delete;
+        ByteRingBuffer &operator=(ByteRingBuffer &&) = delete;
+
+        // Reserves room for a `length`-byte record and returns where to write
+        // it, or an empty span if the ring is full. Records are never empty,
+        // so an empty view always means "nothing here". Nothing is visible to
+        // the consumer until Commit().
+        [[nodiscard]] std::span<std::byte> TryClaim(size_t length) noexcept
+        {
+            if (length == 0 || length > MaxPayload) { return { }; }
+
+            const uint64_t write_pos = m_producer_pos.load(std::memory_order_relaxed);
+            const size_t offset = static_cast<size_t>(write_pos & (Capacity - 1));
+            const size_t tail = Capacity - offset;
+            const size_t record = RecordSize(length);
+            const size_t needed = (record > tail) ? tail + record : record;
+
+            if (Capacity - static_cast<size_t>(write_pos - m_cached_consumer_pos) < needed)
+            {
+                m_cached_consumer_pos = m_consumer_pos.load(std::memory_order_acquire);
+                if (Capacity - static_cast<size_t>(write_pos - m_cached_consumer_pos) < needed)
+                {
+                    return { };
+                }
+            }
+
+            size_t start = offset;
+            if (record > tail)
+            {
+                WriteHeader(offset, SkipMarker);
+                start = 0;
+            }
+
+            WriteHeader(start, static_cast<uint32_t>(length));
+            m_pending_pos = write_pos + needed;
+            return { m_data + start + HeaderSize, length };
+        }
+
+        void Commit() noexcept
+        {
+            m_producer_pos.store(m_pending_pos, std::memory_order_release);
+        }
+
+        [[nodiscard]] bool TryWrite(std::span<const std::byte> bytes) noexcept
+        {
+            auto dst = TryClaim(bytes.size());
+            if (dst.empty()) { return false; }
+            std::memcpy(dst.data(), bytes.data(), bytes.size());
+            Commit();
+            return true;
+        }
+
+        // View of the oldest record, valid until Pop(); empty when there is
+        // nothing to read.
+        [[nodiscard]] std::span<const std::byte> Peek() noexcept
+        {
+            uint64_t read_pos = m_consumer_pos.load(std::memory_order_relaxed);
+            if (!HasData(read_pos)) { return { }; }
+
+            size_t offset = static_cast<size_t>(read_pos & (Capacity - 1));
+            uint32_t length = ReadHeader(offset);
+            if (length == SkipMarker)
+            {
+                // The producer publishes a skip together with the record
+                // behind it, so the record at offset 0 is already visible.
+                read_pos += Capacity - offset;
+                m_consumer_pos.store(read_pos, std::memory_order_release);
+                offset = 0;
+                length = ReadHeader(0);
+            }
+
+            m_next_read_pos = read_pos + RecordSize(length);
+            return { m_data + offset + HeaderSize, length };
+        }
+
+        // Releases the record returned by the last Peek().
+        void Pop() noexcept
+        {
+            m_consumer_pos.store(m_next_read_pos, std::memory_order_release);
+        }
+
+        // Hands up to `max` records to fn and releases them with one store.
+        template <typename Fn>
+            requires std::invocable<Fn&, std::span<const std::byte>>
+        size_t ConsumeN(Fn &&fn, size_t max = Capacity)
+        {
+            const uint64_t start_pos = m_consumer_pos.load(std::memory_order_relaxed);
+            uint64_t read_pos = start_pos;
+            size_t count = 0;
+
+            while (count < max && HasData(read_pos))
+            {
+                const size_t offset = static_cast<size_t>(read_pos & (Capacity - 1));
+                const uint32_t length = ReadHeader(offset);
+                if (length == SkipMarker)
+                {
+                    read_pos += Capacity - offset;
+                    continue;
+                }
+
+                fn(std::span<const std::byte>(m_data + offset + HeaderSize, length));
+                read_pos += RecordSize(length);
+                ++count;
+            }
+
+            if (read_pos != start_pos) { m_consumer_pos.store(read_pos, std::memory_order_release); }
+            return count;
+        }
+
+        // Bytes in use, including headers, padding and skipped tails.
+        [[nodiscard]] size_t Size() const noexcept
+        {
+            return static_cast<size_t>(m_producer_pos.load(std::memory_order_acquire) -
+                                       m_consumer_pos.load(std::memory_order_acquire));
+        }
+
+        [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+
+        [[nodiscard]] constexpr size_t GetCapacity() const noexcept { return Capacity; }
+        [[nodiscard]] const Allocator &GetAllocator() const noexcept { return m_alloc; }
+
+    private:
+        std::byte *m_data;
+
+#ifdef _MSC_VER
+        Allocator m_alloc [[msvc::no_unique_address]];
+#else
+        Allocator m_alloc [[no_unique_address]];
+#endif
+
+        alignas(CacheLineSize) std::atomic<uint64_t> m_producer_pos{ 0 };
+        uint64_t m_cached_consumer_pos{ 0 };
+        uint64_t m_pending_pos{ 0 };
+        alignas(CacheLineSize) std::atomic<uint64_t> m_consumer_pos{ 0 };
+        uint64_t m_cached_producer_pos{ 0 };
+        uint64_t m_next_read_pos{ 0 };
+
+        static constexpr size_t RecordSize(size_t length) noexcept
+        {
+            return (HeaderSize + length + RecordAlign - 1) & ~(RecordAlign - 1);
+        }
+
+        void WriteHeader(size_t offset, uint32_t value) noexcept
+        {
+            std::memcpy(m_data + offset, &value, sizeof(value));
+        }
+
+        uint32_t ReadHeader(size_t offset) const noexcept
+        {
+            uint32_t value;
+            std::memcpy(&value, m_data + offset, sizeof(value));
+            return value;
+        }
+
+        bool HasData(uint64_t read_pos) noexcept
+        {
+            if (read_pos != m_cached_producer_pos) { return true; }
+            m_cached_producer_pos = m_producer_pos.load(std::memory_order_acquire);
+            return read_pos != m_cached_producer_pos;
+        }
+    };
+
+} // namespace hft
+
+#endif // BYTE_RING_BUFFER_H
@@ -0,0 +1,209 @@
+#ifndef HUGE_PAGE_ALLOCATOR_H
+#define HUGE_PAGE_ALLOCATOR_H
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hft
+{
+    // What actually backs an allocation, best first.
+    //  HugeTlb          explicit huge pages (MAP_HUGETLB / MEM_LARGE_PAGES)
+    //  TransparentHuge  regular mapping advised with MADV_HUGEPAGE; the
+    //                   kernel may still use small pages for parts of it
+    //  Regular          ordinary pages
+    enum class PageBacking : uint8_t
+    {
+        None,
+        HugeTlb,
+        TransparentHuge,
+        Regular
+    };
+
+    struct HugePageOptions
+    {
+        bool allow_huge_tlb{ true };
+        bool allow_transparent{ true };
+        bool prefault{ true };
+        bool lock{ false };
+    };
+
+    // Outcome of the most recent allocation made through an allocator (and
+    // its copies), so callers can log what the ring actually got.
+    struct HugePageStats
+    {
+        std::atomic<PageBacking> backing{ PageBacking::None };
+        std::atomic<size_t> mapped_bytes{ 0 };
+        std::atomic<bool> prefaulted{ false };
+        std::atomic<bool> locked{ false };
+    };
+
+    // Allocator for large, long-lived buffers such as ring storage. Memory
+    // comes straight from the OS, huge pages first with a fallback to
+    // regular pages, and every page is touched (and optionally locked) up
+    // front so the first burst through a fresh ring takes no page faults.
+    // Buffers under half a huge page are only page-rounded, never huge.
+    template <typename T>
+    class HugePageAllocator
+    {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        static constexpr size_t HugePageSize = size_t{ 2 } << 20;
+
+        explicit HugePageAllocator(const HugePageOptions &options = { })
+            : m_options(options)
+            , m_stats(std::make_shared<HugePageStats>())
+        { }
+
+        template <typename U>
+        HugePageAllocator(const HugePageAllocator<U> &other) noexcept
+            : m_options(other.m_options)
+            , m_stats(other.m_stats)
+        { }
+
+        [[nodiscard]] T *allocate(size_t n)
+        {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T)) { throw std::bad_array_new_length(); }
+
+            const size_t length = MappedLength(n * sizeof(T));
+            PageBacking backing = PageBacking::None;
+            void *p = Map(length, backing);
+            if (!p) { throw std::bad_alloc(); }
+
+            const bool prefaulted = m_options.prefault && backing != PageBacking::None;
+            if (prefaulted) { Prefault(p, length); }
+            const bool locked = m_options.lock && Lock(p, length);
+
+            m_stats->backing.store(backing, std::memory_order_relaxed);
+            m_stats->mapped_bytes.store(length, std::memory_order_relaxed);
+            m_stats->prefaulted.store(prefaulted, std::memory_order_relaxed);
+            m_stats->locked.store(locked, std::memory_order_relaxed);
+            return static_cast<T *>(p);
+        }
+
+        void deallocate(T *p, size_t n) noexcept
+        {
+            if (!p) { return; }
+#if defined(_WIN32)
+            (void)n;
+            VirtualFree(p, 0, MEM_RELEASE);
+#else
+            ::munmap(p, MappedLength(n * sizeof(T)));
+#endif
+        }
+
+        PageBacking Backing() const noexcept { return m_stats->backing.load(std::memory_order_relaxed); }
+        const HugePageStats &Stats() const noexcept { return *m_stats; }
+        const HugePageOptions &Options() const noexcept { return m_options; }
+
+        template <typename U>
+        bool operator==(const HugePageAllocator<U> &) const noexcept { return true; }
+
+    private:
+        template <typename U>
+        friend class HugePageAllocator;
+
+        HugePageOptions m_options;
+        std::shared_ptr<HugePageStats> m_stats;
+
+        static size_t PageSize() noexcept
+        {
+#if defined(_WIN32)
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return info.dwPageSize;
+#else
+            return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+        }
+
+        // Depends only on the byte count, so deallocate recomputes the
+        // same length whichever backing allocate ended up with.
+        static size_t MappedLength(size_t bytes) noexcept
+        {
+            const size_t granule = (bytes >= HugePageSize / 2) ? HugePageSize : PageSize();
+            return (bytes + granule - 1) / granule * granule;
+        }
+
+        void *Map(size_t length, PageBacking &backing) const noexcept
+        {
+            const bool huge_sized = (length % HugePageSize) == 0;
+#if defined(_WIN32)
+            // Large pages need SeLockMemoryPrivilege and are always locked.
+            const size_t large_page = GetLargePageMinimum();
+            if (huge_sized && m_options.allow_huge_tlb && large_page != 0 && length % large_page == 0)
+            {
+                if (void *p = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+                {
+                    backing = PageBacking::HugeTlb;
+                    return p;
+                }
+            }
+
+            void *p = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+            if (p) { backing = PageBacking::Regular; }
+            return p;
+#else
+            constexpr int Flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_HUGETLB)
+            if (huge_sized && m_options.allow_huge_tlb)
+            {
+                void *p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, Flags | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED)
+                {
+                    backing = PageBacking::HugeTlb;
+                    return p;
+                }
+            }
+#endif
+            void *p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, Flags, -1, 0);
+            if (p == MAP_FAILED) { return nullptr; }
+
+            backing = PageBacking::Regular;
+#if defined(MADV_HUGEPAGE)
+            if (huge_sized && m_options.allow_transparent && ::madvise(p, length, MADV_HUGEPAGE) == 0)
+            {
+                backing = PageBacking::TransparentHuge;
+            }
+#endif
+            return p;
+#endif
+        }
+
+        // One write per small page; volatile so the stores are not elided.
+        static void Prefault(void *p, size_t length) noexcept
+        {
+            const size_t page = PageSize();
+            volatile std::byte *bytes = static_cast<std::byte *>(p);
+            for (size_t offset = 0; offset < length; offset += page)
+            {
+                bytes[offset] = std::byte{ 0 };
+            }
+        }
+
+        static bool Lock(void *p, size_t length) noexcept
+        {
+#if defined(_WIN32)
+            return VirtualLock(p, length) != 0;
+#else
+            return ::mlock(p, length) == 0;
+#endif
+        }
+    };
+
+} // namespace hft
+
+#endif // HUGE_PAGE_ALLOCATOR_H
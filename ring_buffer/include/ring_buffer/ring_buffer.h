@@ -8,6 +8,10 @@
 #include <concepts>
 #include <type_traits>
 #include <limits>
+#include <span>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
 
 namespace hft
 {
@@ -26,6 +30,11 @@ namespace hft
     template <typename T>
     concept no_throw_destructible = std::is_nothrow_destructible_v<T>;
 
+    // Slots that may be written without constructing and dropped without
+    // destroying, as the claim/commit API does.
+    template <typename T>
+    concept in_place_slot = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
     
     template <typename T, size_t Capacity, typename Allocator = std::allocator<T>> 
         requires power_of_two<Capacity> 
@@ -77,11 +86,16 @@ namespace hft
         {
             const auto write_index = m_producer_index.load(std::memory_order_relaxed);
             const auto next_write = (write_index + 1) & (Capacity - 1);
-            const auto read_index = m_consumer_index.load(std::memory_order_acquire);
 
-            if (next_write == read_index)
+            // Only reload the consumer's index when the cached copy says
+            // the ring is full; most pushes never touch its cache line.
+            if (next_write == m_cached_consumer_index)
             {
-                return false;
+                m_cached_consumer_index = m_consumer_index.load(std::memory_order_acquire);
+                if (next_write == m_cached_consumer_index)
+                {
+                    return false;
+                }
             }
 
             new(&m_data[write_index + Padding]) T(std::forward<Args>(args)...);
@@ -98,12 +112,38 @@ namespace hft
             return TryEmplace(std::forward<Value>(value));
         }
 
+        // Copies as many leading items as fit and publishes them with a
+        // single release store. Returns the number pushed.
+        size_t TryPushN(std::span<const T> items) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        requires std::copy_constructible<T>
+        {
+            const auto write_index = m_producer_index.load(std::memory_order_relaxed);
+
+            size_t free = FreeSlots(write_index, m_cached_consumer_index);
+            if (free < items.size())
+            {
+                m_cached_consumer_index = m_consumer_index.load(std::memory_order_acquire);
+                free = FreeSlots(write_index, m_cached_consumer_index);
+            }
+
+            const size_t count = std::min(free, items.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                new(&m_data[((write_index + i) & (Capacity - 1)) + Padding]) T(items[i]);
+            }
+
+            if (count > 0)
+            {
+                m_producer_index.store((write_index + count) & (Capacity - 1), std::memory_order_release);
+            }
+            return count;
+        }
+
         [[nodiscard]] bool TryPop() noexcept 
         requires no_throw_destructible<T>
         {
             const auto read_index = m_consumer_index.load(std::memory_order_relaxed);
-            const auto write_index = m_producer_index.load(std::memory_order_acquire);
-            if (read_index == write_index)
+            if (!ConsumerHasData(read_index))
             {
                 return false;
             }
@@ -114,11 +154,40 @@ namespace hft
             return true;
         }
 
+        // Hands up to `max` elements to fn in place, oldest first, destroys
+        // them and frees their slots with a single release store.
+        template <typename Fn>
+        requires std::invocable<Fn&, T&> && no_throw_destructible<T>
+        size_t PopN(Fn &&fn, size_t max = Capacity) noexcept(std::is_nothrow_invocable_v<Fn&, T&>)
+        {
+            const auto read_index = m_consumer_index.load(std::memory_order_relaxed);
+
+            size_t available = UsedSlots(m_cached_producer_index, read_index);
+            if (available < max)
+            {
+                m_cached_producer_index = m_producer_index.load(std::memory_order_acquire);
+                available = UsedSlots(m_cached_producer_index, read_index);
+            }
+
+            const size_t count = std::min(available, max);
+            for (size_t i = 0; i < count; ++i)
+            {
+                T &value = m_data[((read_index + i) & (Capacity - 1)) + Padding];
+                fn(value);
+                value.~T();
+            }
+
+            if (count > 0)
+            {
+                m_consumer_index.store((read_index + count) & (Capacity - 1), std::memory_order_release);
+            }
+            return count;
+        }
+
         [[nodiscard]] T *Peek() noexcept
         {
             const auto read_index = m_consumer_index.load(std::memory_order_relaxed);
-            const auto write_index = m_producer_index.load(std::memory_order_acquire);
-            if (read_index == write_index)
+            if (!ConsumerHasData(read_index))
             {
                 return nullptr;
             }
@@ -126,6 +195,73 @@ namespace hft
             return &m_data[read_index + Padding];
         }
 
+        // Two-phase, zero-copy access for implicit-lifetime types. The
+        // producer claims raw slots, writes them in place and commits; the
+        // consumer reads a view in place and releases it. Nothing is built
+        // outside the ring and no constructor or destructor runs. Claims and
+        // views are contiguous, so a batch stops at the end of storage and
+        // the next call continues from the start.
+        [[nodiscard]] T *TryClaim() noexcept
+        requires in_place_slot<T>
+        {
+            auto slots = ClaimN(1);
+            return slots.empty() ? nullptr : slots.data();
+        }
+
+        void Commit() noexcept
+        requires in_place_slot<T>
+        {
+            CommitN(1);
+        }
+
+        [[nodiscard]] std::span<T> ClaimN(size_t max) noexcept
+        requires in_place_slot<T>
+        {
+            const auto write_index = m_producer_index.load(std::memory_order_relaxed);
+
+            size_t free = FreeSlots(write_index, m_cached_consumer_index);
+            if (free < max)
+            {
+                m_cached_consumer_index = m_consumer_index.load(std::memory_order_acquire);
+                free = FreeSlots(write_index, m_cached_consumer_index);
+            }
+
+            const size_t count = std::min({ free, max, static_cast<size_t>(Capacity - write_index) });
+            return { &m_data[write_index + Padding], count };
+        }
+
+        // Publishes the first n slots of the last claim.
+        void CommitN(size_t n) noexcept
+        requires in_place_slot<T>
+        {
+            const auto write_index = m_producer_index.load(std::memory_order_relaxed);
+            m_producer_index.store((write_index + n) & (Capacity - 1), std::memory_order_release);
+        }
+
+        [[nodiscard]] std::span<T> PeekN(size_t max) noexcept
+        requires in_place_slot<T>
+        {
+            const auto read_index = m_consumer_index.load(std::memory_order_relaxed);
+
+            size_t available = UsedSlots(m_cached_producer_index, read_index);
+            if (available < max)
+            {
+                m_cached_producer_index = m_producer_index.load(std::memory_order_acquire);
+                available = UsedSlots(m_cached_producer_index, read_index);
+            }
+
+            const size_t count = std::min({ available, max, static_cast<size_t>(Capacity - read_index) });
+            return { &m_data[read_index + Padding], count };
+        }
+
+        // Hands the first n slots of the last view back to the producer.
+        void Release(size_t n) noexcept
+        requires in_place_slot<T>
+        {
+            const auto read_index = m_consumer_index.load(std::memory_order_relaxed);
+            m_consumer_index.store((read_index + n) & (Capacity - 1), std::memory_order_release);
+        }
+
         [[nodiscard]] size_t Size() const noexcept
         {
             std::ptrdiff_t offset =
@@ -147,6 +283,7 @@ namespace hft
         }
 
         [[nodiscard]] constexpr size_t GetCapacity() const noexcept { return Capacity - 1; }
+        [[nodiscard]] const Allocator &GetAllocator() const noexcept { return m_alloc; }
 
     private:
         T* m_data;
@@ -157,10 +294,211 @@ namespace hft
         Allocator m_alloc [[no_unique_address]];
 #endif
 
+        // Each side's cached copy of the other's index shares a line with the
+        // index it owns, so the remote line is only pulled in on apparent
+        // full/empty.
         alignas(CacheLineSize) std::atomic<uint64_t> m_producer_index{ 0 };
+        uint64_t m_cached_consumer_index{ 0 };
         alignas(CacheLineSize) std::atomic<uint64_t> m_consumer_index{ 0 };
+        uint64_t m_cached_producer_index{ 0 };
+
+        static constexpr size_t UsedSlots(uint64_t write_index, uint64_t read_index) noexcept
+        {
+            return static_cast<size_t>((write_index - read_index) & (Capacity - 1));
+        }
+
+        static constexpr size_t FreeSlots(uint64_t write_index, uint64_t read_index) noexcept
+        {
+            return Capacity - 1 - UsedSlots(write_index, read_index);
+        }
+
+        bool ConsumerHasData(uint64_t read_index) noexcept
+        {
+            if (read_index != m_cached_producer_index) { return true; }
+            m_cached_producer_index = m_producer_index.load(std::memory_order_acquire);
+            return read_index != m_cached_producer_index;
+        }
+    };
+
+    // Bounded multi-producer/multi-consumer queue. Every slot carries a
+    // sequence number that says whose turn it is: a producer at position pos
+    // may write once sequence == pos, a consumer may read once
+    // sequence == pos + 1. The enqueue/dequeue cursors are only contended by
+    // their own side, each on its own cache line, and all Capacity slots are
+    // usable. A claimed slot has to be filled, so element construction must
+    // not throw.
+    template <typename T, size_t Capacity, typename Allocator = std::allocator<T>>
+        requires power_of_two<Capacity>
+    class MPMCRingBuffer
+    {
+        static constexpr size_t CacheLineSize = std::hardware_destructive_interference_size;
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T *Get() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+        };
+
+        using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+        using AllocTraits = std::allocator_traits<SlotAllocator>;
+        static constexpr size_t Padding = (CacheLineSize - 1) / sizeof(Slot) + 1;
+
+    public:
+        explicit MPMCRingBuffer(const Allocator &alloc = Allocator())
+            : m_alloc(alloc)
+        {
+            if constexpr (has_allocate_at_least<SlotAllocator>)
+            {
+                m_slots = m_alloc.allocate_at_least(Capacity + 2 * Padding).ptr;
+            }
+            else
+            {
+                m_slots = AllocTraits::allocate(m_alloc, Capacity + 2 * Padding);
+            }
+
+            for (size_t i = 0; i < Capacity; ++i)
+            {
+                std::construct_at(&m_slots[i + Padding].sequence, i);
+            }
+        }
+
+        ~MPMCRingBuffer()
+        {
+            while (TryConsume([](T &) { }));
+            for (size_t i = 0; i < Capacity; ++i)
+            {
+                std::destroy_at(&m_slots[i + Padding].sequence);
+            }
+            AllocTraits::deallocate(m_alloc, m_slots, Capacity + 2 * Padding);
+        }
+
+        MPMCRingBuffer(const MPMCRingBuffer &) = delete;
+        MPMCRingBuffer &operator=(const MPMCRingBuffer &) = delete;
+
+        MPMCRingBuffer(MPMCRingBuffer &&) = delete;
+        MPMCRingBuffer &operator=(MPMCRingBuffer &&) = delete;
+
+        template <typename... Args>
+            requires std::is_nothrow_constructible_v<T, Args&&...>
+        [[nodiscard]] bool TryEmplace(Args&&... args) noexcept
+        {
+            size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            Slot *slot;
+            for (;;)
+            {
+                slot = &SlotAt(pos);
+                const size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+                if (diff == 0)
+                {
+                    if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::construct_at(slot->Get(), std::forward<Args>(args)...);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename Value>
+            requires std::is_nothrow_constructible_v<T, Value&&>
+        [[nodiscard]] bool TryPush(Value&& value) noexcept
+        {
+            return TryEmplace(std::forward<Value>(value));
+        }
+
+        // Claims the oldest element, hands it to fn in place and destroys it.
+        // This is the MPMC counterpart of Peek + TryPop: another consumer
+        // cannot steal the element between the two.
+        template <typename Fn>
+            requires std::invocable<Fn&, T&>
+        [[nodiscard]] bool TryConsume(Fn &&fn) noexcept(std::is_nothrow_invocable_v<Fn&, T&>)
+            requires no_throw_destructible<T>
+        {
+            size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            Slot *slot;
+            for (;;)
+            {
+                slot = &SlotAt(pos);
+                const size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+
+                if (diff == 0)
+                {
+                    if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            // Release the slot even if fn throws, otherwise producers wedge.
+            struct Recycle
+            {
+                Slot *slot;
+                size_t next;
+                ~Recycle()
+                {
+                    std::destroy_at(slot->Get());
+                    slot->sequence.store(next, std::memory_order_release);
+                }
+            } recycle{ slot, pos + Capacity };
+
+            fn(*slot->Get());
+            return true;
+        }
+
+        [[nodiscard]] bool TryPop(T &out) noexcept(std::is_nothrow_move_assignable_v<T>)
+            requires no_throw_destructible<T>
+        {
+            return TryConsume([&out](T &value) { out = std::move(value); });
+        }
+
+        // Approximate under concurrency: the cursors are read independently.
+        [[nodiscard]] size_t Size() const noexcept
+        {
+            const size_t dequeue = m_dequeue_pos.load(std::memory_order_acquire);
+            const size_t enqueue = m_enqueue_pos.load(std::memory_order_acquire);
+            return (enqueue > dequeue) ? std::min(enqueue - dequeue, Capacity) : 0;
+        }
+
+        [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+
+        [[nodiscard]] constexpr size_t GetCapacity() const noexcept { return Capacity; }
+        [[nodiscard]] Allocator GetAllocator() const noexcept { return Allocator(m_alloc); }
+
+    private:
+        Slot *m_slots;
+
+#ifdef _MSC_VER
+        SlotAllocator m_alloc [[msvc::no_unique_address]];
+#else
+        SlotAllocator m_alloc [[no_unique_address]];
+#endif
+
+        alignas(CacheLineSize) std::atomic<size_t> m_enqueue_pos{ 0 };
+        alignas(CacheLineSize) std::atomic<size_t> m_dequeue_pos{ 0 };
+
+        Slot &SlotAt(size_t pos) noexcept { return m_slots[(pos & (Capacity - 1)) + Padding]; }
     };
 
+
 } // namespace hft
 
 #endif
\ No newline at end of file
@@ -0,0 +1,382 @@
+#ifndef SHM_RING_BUFFER_H
+#define SHM_RING_BUFFER_H
+
+#include <new>
+#include <atomic>
+#include <string>
+#include <span>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ring_buffer/ring_buffer.h"
+
+namespace hft
+{
+    enum class ShmRole : uint8_t
+    {
+        Producer,
+        Consumer
+    };
+
+    // SPSCRingBuffer whose indices and slots live in a named POSIX
+    // shared-memory segment, so producer and consumer can be separate
+    // processes. The segment starts with a versioned header (magic, version,
+    // capacity, element size/alignment) that Attach() checks against the
+    // template arguments, followed by producer and consumer lines on their
+    // own cache lines, then the slots.
+    //
+    // Indices are free-running counters stored in the segment, so either side
+    // can restart and resume where the segment says it left off. Each role is
+    // claimed by pid; a live owner makes a second claim fail, a dead one is
+    // taken over. A producer takeover bumps ProducerEpoch() so the consumer
+    // can tell a restart happened. A crash between writing a slot and
+    // publishing it loses only that unpublished item. Pid reuse after a
+    // crash can make a dead owner look alive; Unlink and recreate then.
+    template <typename T, size_t Capacity>
+        requires power_of_two<Capacity> && std::is_trivially_copyable_v<T>
+    class ShmSPSCRingBuffer
+    {
+        static constexpr size_t CacheLineSize = 64;
+        static constexpr uint64_t Magic = 0x3143535053544648ull; // "HFTSPSC1"
+        static constexpr uint32_t Version = 2;
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared atomics must be lock-free");
+
+        struct Header
+        {
+            uint64_t magic;
+            uint32_t version;
+            std::atomic<uint32_t> ready;
+            uint64_t capacity;
+            uint64_t element_size;
+            uint64_t element_align;
+        };
+
+        struct Control
+        {
+            alignas(CacheLineSize) Header header;
+
+            alignas(CacheLineSize) std::atomic<uint64_t> producer_index;
+            std::atomic<int64_t> producer_pid;
+            std::atomic<uint32_t> producer_epoch;
+
+            alignas(CacheLineSize) std::atomic<uint64_t> consumer_index;
+            std::atomic<int64_t> consumer_pid;
+        };
+
+        // Slots start on a cache line, or on T's own boundary if that is
+        // stricter; the segment itself is page-aligned by mmap.
+        static constexpr size_t DataAlign = std::max(CacheLineSize, alignof(T));
+        static_assert(DataAlign <= 4096, "Element alignment exceeds the mapping's page alignment");
+
+        static constexpr size_t DataOffset = (sizeof(Control) + DataAlign - 1) / DataAlign * DataAlign;
+        static constexpr size_t SegmentSize = DataOffset + Capacity * sizeof(T);
+
+    public:
+        // Creates a new segment and claims `role` in it. Fails if a segment
+        // with that name already exists.
+        static ShmSPSCRingBuffer Create(const std::string &name, ShmRole role)
+        {
+            const std::string path = SegmentPath(name);
+            int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) { ThrowErrno("shm_open(create) " + path); }
+
+            if (::ftruncate(fd, static_cast<off_t>(SegmentSize)) != 0)
+            {
+                const int err = errno;
+                ::close(fd);
+                ::shm_unlink(path.c_str());
+                throw std::system_error(err, std::generic_category(), "ftruncate " + path);
+            }
+
+            try
+            {
+                void *base = Map(fd, path);
+
+                Control *control = new (base) Control{ };
+                control->header.magic = Magic;
+                control->header.version = Version;
+                control->header.capacity = Capacity;
+                control->header.element_size = sizeof(T);
+                control->header.element_align = alignof(T);
+                control->header.ready.store(1, std::memory_order_release);
+
+                return ShmSPSCRingBuffer(fd, base, role);
+            }
+            catch (...)
+            {
+                // Map and the constructor release fd and the mapping on
+                // failure; drop the name too so a retry can create it.
+                ::shm_unlink(path.c_str());
+                throw;
+            }
+        }
+
+        // Maps an existing segment and claims `role` in it. Throws if the
+        // segment is missing, not yet initialised or was created for a
+        // different element type or capacity.
+        static ShmSPSCRingBuffer Attach(const std::string &name, ShmRole role)
+        {
+            const std::string path = SegmentPath(name);
+            int fd = ::shm_open(path.c_str(), O_RDWR, 0600);
+            if (fd < 0) { ThrowErrno("shm_open(attach) " + path); }
+
+            struct stat st{ };
+            if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Control))
+            {
+                ::close(fd);
+                throw std::runtime_error("Shared ring segment is not initialised: " + path);
+            }
+
+            void *base = Map(fd, path);
+            const Header &header = static_cast<Control *>(base)->header;
+            const bool matches = header.ready.load(std::memory_order_acquire) == 1 &&
+                                 header.magic == Magic && header.version == Version &&
+                                 header.capacity == Capacity && header.element_size == sizeof(T) &&
+                                 header.element_align == alignof(T) &&
+                                 static_cast<size_t>(st.st_size) >= SegmentSize;
+            if (!matches)
+            {
+                ::munmap(base, SegmentSize);
+                ::close(fd);
+                throw std::runtime_error("Shared ring segment layout mismatch: " + path);
+            }
+
+            return ShmSPSCRingBuffer(fd, base, role);
+        }
+
+        // Removes the name; processes that still map the segment keep it.
+        static bool Unlink(const std::string &name) noexcept
+        {
+            return ::shm_unlink(SegmentPath(name).c_str()) == 0;
+        }
+
+        ~ShmSPSCRingBuffer()
+        {
+            Close();
+        }
+
+        ShmSPSCRingBuffer(const ShmSPSCRingBuffer &) = delete;
+        ShmSPSCRingBuffer &operator=(const ShmSPSCRingBuffer &) = delete;
+
+        ShmSPSCRingBuffer(ShmSPSCRingBuffer &&other) noexcept
+            : m_fd(std::exchange(other.m_fd, -1))
+            , m_base(std::exchange(other.m_base, nullptr))
+            , m_control(std::exchange(other.m_control, nullptr))
+            , m_data(std::exchange(other.m_data, nullptr))
+            , m_role(other.m_role)
+            , m_cached_remote(other.m_cached_remote)
+        { }
+
+        ShmSPSCRingBuffer &operator=(ShmSPSCRingBuffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                Close();
+                m_fd = std::exchange(other.m_fd, -1);
+                m_base = std::exchange(other.m_base, nullptr);
+                m_control = std::exchange(other.m_control, nullptr);
+                m_data = std::exchange(other.m_data, nullptr);
+                m_role = other.m_role;
+                m_cached_remote = other.m_cached_remote;
+            }
+            return *this;
+        }
+
+        [[nodiscard]] bool TryPush(const T &value) noexcept
+        {
+            return TryPushN(std::span<const T>(&value, 1)) == 1;
+        }
+
+        // Copies as many leading items as fit and publishes them with a
+        // single release store. Producer only.
+        size_t TryPushN(std::span<const T> items) noexcept
+        {
+            const uint64_t write = m_control->producer_index.load(std::memory_order_relaxed);
+
+            size_t free = Capacity - static_cast<size_t>(write - m_cached_remote);
+            if (free < items.size())
+            {
+                m_cached_remote = m_control->consumer_index.load(std::memory_order_acquire);
+                free = Capacity - static_cast<size_t>(write - m_cached_remote);
+            }
+
+            const size_t count = std::min(free, items.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::memcpy(&m_data[(write + i) & (Capacity - 1)], &items[i], sizeof(T));
+            }
+
+            if (count > 0)
+            {
+                m_control->producer_index.store(write + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        [[nodiscard]] bool TryPop(T &out) noexcept
+        {
+            return PopN([&out](const T &item) { out = item; }, 1) == 1;
+        }
+
+        // Hands up to `max` items to fn(const T&) and releases them with one
+        // store. Consumer only.
+        template <typename Fn>
+        size_t PopN(Fn &&fn, size_t max = Capacity)
+        {
+            const uint64_t read = m_control->consumer_index.load(std::memory_order_relaxed);
+            if (read == m_cached_remote)
+            {
+                m_cached_remote = m_control->producer_index.load(std::memory_order_acquire);
+                if (read == m_cached_remote) { return 0; }
+            }
+
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(m_cached_remote - read, max));
+            for (size_t i = 0; i < count; ++i)
+            {
+                fn(static_cast<const T &>(m_data[(read + i) & (Capacity - 1)]));
+            }
+
+            m_control->consumer_index.store(read + count, std::memory_order_release);
+            return count;
+        }
+
+        size_t Size() const noexcept
+        {
+            const uint64_t read = m_control->consumer_index.load(std::memory_order_acquire);
+            const uint64_t write = m_control->producer_index.load(std::memory_order_acquire);
+            return static_cast<size_t>(write - std::min(read, write));
+        }
+
+        bool Empty() const noexcept { return Size() == 0; }
+        size_t GetCapacity() const noexcept { return Capacity; }
+        ShmRole Role() const noexcept { return m_role; }
+
+        // Incremented every time a producer claims the segment.
+        uint32_t ProducerEpoch() const noexcept
+        {
+            return m_control->producer_epoch.load(std::memory_order_acquire);
+        }
+
+    private:
+        int m_fd{ -1 };
+        void *m_base{ nullptr };
+        Control *m_control{ nullptr };
+        T *m_data{ nullptr };
+        ShmRole m_role{ ShmRole::Consumer };
+        uint64_t m_cached_remote{ 0 };
+
+        ShmSPSCRingBuffer(int fd, void *base, ShmRole role)
+            : m_fd(fd)
+            , m_base(base)
+            , m_control(static_cast<Control *>(base))
+            , m_data(reinterpret_cast<T *>(static_cast<std::byte *>(base) + DataOffset))
+            , m_role(role)
+        {
+            try
+            {
+                ClaimRole();
+            }
+            catch (...)
+            {
+                ::munmap(m_base, SegmentSize);
+                ::close(m_fd);
+                throw;
+            }
+
+            // Resume from the indices the segment holds. A consumer starts
+            // with nothing known to be readable and reloads on first pop.
+            if (m_role == ShmRole::Producer)
+            {
+                m_cached_remote = m_control->consumer_index.load(std::memory_order_acquire);
+            }
+            else
+            {
+                m_cached_remote = m_control->consumer_index.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<int64_t> &OwnerPid() noexcept
+        {
+            return (m_role == ShmRole::Producer) ? m_control->producer_pid : m_control->consumer_pid;
+        }
+
+        void ClaimRole()
+        {
+            const int64_t self = static_cast<int64_t>(::getpid());
+            std::atomic<int64_t> &owner = OwnerPid();
+
+            int64_t current = 0;
+            while (!owner.compare_exchange_strong(current, self, std::memory_order_acq_rel))
+            {
+                if (current == self || ProcessAlive(current))
+                {
+                    throw std::runtime_error("Shared ring role is already owned by a live process");
+                }
+            }
+
+            if (m_role == ShmRole::Producer)
+            {
+                m_control->producer_epoch.fetch_add(1, std::memory_order_acq_rel);
+            }
+        }
+
+        void Close() noexcept
+        {
+            if (!m_base) { return; }
+
+            int64_t self = static_cast<int64_t>(::getpid());
+            OwnerPid().compare_exchange_strong(self, 0, std::memory_order_acq_rel);
+
+            ::munmap(m_base, SegmentSize);
+            ::close(m_fd);
+            m_base = nullptr;
+            m_control = nullptr;
+            m_data = nullptr;
+            m_fd = -1;
+        }
+
+        static bool ProcessAlive(int64_t pid) noexcept
+        {
+            return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+        }
+
+        static std::string SegmentPath(const std::string &name)
+        {
+            return (!name.empty() && name.front() == '/') ? name : "/" + name;
+        }
+
+        static void *Map(int fd, const std::string &path)
+        {
+            void *base = ::mmap(nullptr, SegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (base == MAP_FAILED)
+            {
+                const int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "mmap " + path);
+            }
+            return base;
+        }
+
+        [[noreturn]] static void ThrowErrno(const std::string &what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+    };
+
+} // namespace hft
+
+#endif // SHM_RING_BUFFER_H
@@ -0,0 +1,185 @@
+#ifndef WAIT_STRATEGY_H
+#define WAIT_STRATEGY_H
+
+#include <new>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(_M_ARM64)
+#include <intrin.h>
+#endif
+
+namespace hft
+{
+    // Spin-loop hint: lets the sibling hyperthread run and avoids the
+    // memory-order mis-speculation penalty when the awaited line changes.
+    inline void CpuRelax() noexcept
+    {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(_M_ARM64)
+        __yield();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // How a stage idles when its input is empty (or its output is full).
+    //  BusySpin     pause in a loop; lowest wake-up latency, burns a core.
+    //  SpinYield    spin, then yield the core on every further idle poll.
+    //  SpinPark     spin, yield, then block until the producer signals.
+    //  TimedHybrid  spin, then yield, then sleep, each for a bounded time;
+    //               needs no producer cooperation.
+    enum class WaitMode : uint8_t
+    {
+        BusySpin,
+        SpinYield,
+        SpinPark,
+        TimedHybrid
+    };
+
+    struct WaitConfig
+    {
+        WaitMode mode{ WaitMode::TimedHybrid };
+        uint32_t spin_iterations{ 256 };
+        uint32_t yield_iterations{ 64 };
+        std::chrono::microseconds spin_for{ 20 };
+        std::chrono::microseconds yield_for{ 200 };
+        std::chrono::microseconds sleep_for{ 50 };
+    };
+
+    // Wake-up channel between a producer and a consumer that may park.
+    // The consumer samples Epoch() before polling its ring and parks on that
+    // value, so a push + Notify() that lands between the poll and the park
+    // still wakes it. Notify() is one RMW plus a load when nobody is parked.
+    class WaitSignal
+    {
+    public:
+        uint32_t Epoch() const noexcept { return m_epoch.load(std::memory_order_acquire); }
+
+        void Notify() noexcept
+        {
+            m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            if (m_waiters.load(std::memory_order_seq_cst) != 0)
+            {
+                m_epoch.notify_all();
+            }
+        }
+
+        void Wait(uint32_t epoch) noexcept
+        {
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            m_epoch.wait(epoch, std::memory_order_acquire);
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+    private:
+        alignas(std::hardware_destructive_interference_size) std::atomic<uint32_t> m_epoch{ 0 };
+        std::atomic<uint32_t> m_waiters{ 0 };
+    };
+
+    // Producer side of the handshake: only a SpinPark consumer ever blocks
+    // on the signal, so other modes skip the notify.
+    inline void Wake(const WaitConfig &consumer, WaitSignal &signal) noexcept
+    {
+        if (consumer.mode == WaitMode::SpinPark) { signal.Notify(); }
+    }
+
+    // Per-stage idle state. Call Idle() each time a poll finds nothing and
+    // Reset() once it finds work; Idle() escalates through the configured
+    // mode. Without a signal, SpinPark stops at yielding.
+    //
+    //     while (running)
+    //     {
+    //         if (ring.PopN(handle) == 0) { waiter.Idle(); continue; }
+    //         waiter.Reset();
+    //     }
+    class IdleWaiter
+    {
+        using Clock = std::chrono::steady_clock;
+
+    public:
+        explicit IdleWaiter(const WaitConfig &config = { }, WaitSignal *signal = nullptr) noexcept
+            : m_config(config)
+            , m_signal(signal)
+        {
+            Reset();
+        }
+
+        void Reset() noexcept
+        {
+            m_idle_polls = 0;
+            m_idle_since = Clock::time_point{ };
+            if (m_signal) { m_epoch = m_signal->Epoch(); }
+        }
+
+        void Idle() noexcept
+        {
+            switch (m_config.mode)
+            {
+            case WaitMode::BusySpin:
+                CpuRelax();
+                break;
+
+            case WaitMode::SpinYield:
+                if (m_idle_polls < m_config.spin_iterations) { CpuRelax(); }
+                else { std::this_thread::yield(); }
+                break;
+
+            case WaitMode::SpinPark:
+                if (m_idle_polls < m_config.spin_iterations) { CpuRelax(); }
+                else if (m_idle_polls < m_config.spin_iterations + m_config.yield_iterations || !m_signal)
+                {
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    m_signal->Wait(m_epoch);
+                }
+                break;
+
+            case WaitMode::TimedHybrid:
+                IdleTimed();
+                break;
+            }
+
+            if (m_idle_polls != UINT32_MAX) { ++m_idle_polls; }
+            if (m_signal) { m_epoch = m_signal->Epoch(); }
+        }
+
+        const WaitConfig &Config() const noexcept { return m_config; }
+
+    private:
+        WaitConfig m_config;
+        WaitSignal *m_signal;
+        uint32_t m_epoch{ 0 };
+        uint32_t m_idle_polls{ 0 };
+        Clock::time_point m_idle_since{ };
+
+        void IdleTimed() noexcept
+        {
+            // Reading the clock costs about as much as a few pauses, so only
+            // start timing once the spin budget in iterations is used up.
+            if (m_idle_polls < m_config.spin_iterations)
+            {
+                CpuRelax();
+                return;
+            }
+
+            const auto now = Clock::now();
+            if (m_idle_since == Clock::time_point{ }) { m_idle_since = now; }
+
+            const auto idle = now - m_idle_since;
+            if (idle < m_config.spin_for) { CpuRelax(); }
+            else if (idle < m_config.spin_for + m_config.yield_for) { std::this_thread::yield(); }
+            else { std::this_thread::sleep_for(m_config.sleep_for); }
+        }
+    };
+
+} // namespace hft
+
+#endif // WAIT_STRATEGY_H
@@ -1,7 +1,19 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <iostream>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <cstring>
 #include "ring_buffer/ring_buffer.h"
+#include "ring_buffer/byte_ring_buffer.h"
+#include "ring_buffer/broadcast_ring_buffer.h"
+#include "ring_buffer/wait_strategy.h"
+#include "ring_buffer/huge_page_allocator.h"
 
 using namespace hft;
 
@@ -30,3 +42,424 @@ TEST(SPSCRingBuffer, FunctionalityTest)
     ASSERT_TRUE(rb.TryEmplace());
 
 }
+
+TEST(SPSCRingBuffer, BatchPushPop)
+{
+    SPSCRingBuffer<int, 8> rb;
+    const std::array<int, 10> items{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    ASSERT_EQ(rb.TryPushN(items), 7u);
+    ASSERT_EQ(rb.TryPushN(items), 0u);
+    ASSERT_EQ(rb.Size(), 7u);
+
+    std::vector<int> out;
+    auto collect = [&out](int &value) { out.push_back(value); };
+
+    ASSERT_EQ(rb.PopN(collect, 3), 3u);
+    ASSERT_EQ(out, (std::vector<int>{ 0, 1, 2 }));
+
+    // Wraps around the end of the storage.
+    ASSERT_EQ(rb.TryPushN(std::span(items).subspan(7)), 3u);
+    ASSERT_EQ(rb.PopN(collect), 7u);
+    ASSERT_EQ(out, (std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    ASSERT_TRUE(rb.Empty());
+    ASSERT_EQ(rb.PopN(collect), 0u);
+}
+
+TEST(SPSCRingBuffer, BatchesAcrossThreads)
+{
+    constexpr uint64_t N = 200000;
+    SPSCRingBuffer<uint64_t, 256> rb;
+
+    std::thread producer([&rb]()
+        {
+            std::array<uint64_t, 32> batch;
+            uint64_t next = 0;
+            while (next < N)
+            {
+                size_t n = std::min<uint64_t>(batch.size(), N - next);
+                for (size_t i = 0; i < n; ++i) { batch[i] = next + i; }
+
+                size_t pushed = 0;
+                while (pushed < n)
+                {
+                    size_t step = rb.TryPushN(std::span<const uint64_t>(batch).subspan(pushed, n - pushed));
+                    if (step == 0) { std::this_thread::yield(); }
+                    pushed += step;
+                }
+                next += n;
+            }
+        });
+
+    uint64_t expected = 0;
+    bool in_order = true;
+    while (expected < N)
+    {
+        if (rb.PopN([&](uint64_t &value) { in_order = in_order && (value == expected++); }, 64) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(rb.Empty());
+}
+
+TEST(MPMCRingBuffer, FunctionalityTest)
+{
+    MPMCRingBuffer<int, 8> rb;
+
+    int out = -1;
+    ASSERT_TRUE(rb.Empty());
+    ASSERT_FALSE(rb.TryPop(out));
+    ASSERT_EQ(rb.GetCapacity(), 8u);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(rb.TryPush(i));
+    }
+    ASSERT_FALSE(rb.TryPush(8));
+    ASSERT_EQ(rb.Size(), 8u);
+
+    ASSERT_TRUE(rb.TryPop(out));
+    ASSERT_EQ(out, 0);
+    ASSERT_TRUE(rb.TryConsume([](int &value) { EXPECT_EQ(value, 1); }));
+    ASSERT_TRUE(rb.TryPush(8));
+
+    for (int expected = 2; expected <= 8; ++expected)
+    {
+        ASSERT_TRUE(rb.TryPop(out));
+        ASSERT_EQ(out, expected);
+    }
+    ASSERT_TRUE(rb.Empty());
+}
+
+TEST(MPMCRingBuffer, DestroysRemainingElements)
+{
+    auto tracker = std::make_shared<int>(0);
+    {
+        MPMCRingBuffer<std::shared_ptr<int>, 4> rb;
+        ASSERT_TRUE(rb.TryPush(tracker));
+        ASSERT_TRUE(rb.TryPush(tracker));
+        ASSERT_EQ(tracker.use_count(), 3);
+    }
+    ASSERT_EQ(tracker.use_count(), 1);
+}
+
+TEST(MPMCRingBuffer, ManyProducersManyConsumers)
+{
+    constexpr int Producers = 4;
+    constexpr int Consumers = 4;
+    constexpr uint64_t PerProducer = 50000;
+    MPMCRingBuffer<uint64_t, 1024> rb;
+
+    std::atomic<uint64_t> consumed{ 0 };
+    std::atomic<uint64_t> sum{ 0 };
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < Producers; ++p)
+    {
+        threads.emplace_back([&rb, p]()
+            {
+                for (uint64_t i = 0; i < PerProducer; ++i)
+                {
+                    const uint64_t value = p * PerProducer + i;
+                    while (!rb.TryPush(value)) { std::this_thread::yield(); }
+                }
+            });
+    }
+
+    for (int c = 0; c < Consumers; ++c)
+    {
+        threads.emplace_back([&]()
+            {
+                uint64_t value;
+                while (consumed.load(std::memory_order_relaxed) < Producers * PerProducer)
+                {
+                    if (rb.TryPop(value))
+                    {
+                        sum.fetch_add(value, std::memory_order_relaxed);
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+    }
+
+    for (auto &t : threads) { t.join(); }
+
+    const uint64_t n = Producers * PerProducer;
+    EXPECT_EQ(consumed.load(), n);
+    EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+    EXPECT_TRUE(rb.Empty());
+}
+
+TEST(SPSCRingBuffer, ClaimCommitInPlace)
+{
+    struct Message
+    {
+        uint64_t seq;
+        char payload[48];
+    };
+    SPSCRingBuffer<Message, 8> rb;
+
+    Message *slot = rb.TryClaim();
+    ASSERT_NE(slot, nullptr);
+    slot->seq = 1;
+    ASSERT_TRUE(rb.Empty());
+    rb.Commit();
+    ASSERT_EQ(rb.Size(), 1u);
+
+    // Batch claim stops at the end of storage; the rest comes on the next call.
+    auto claimed = rb.ClaimN(16);
+    ASSERT_EQ(claimed.size(), 6u);
+    for (size_t i = 0; i < claimed.size(); ++i) { claimed[i].seq = 2 + i; }
+    rb.CommitN(claimed.size());
+    ASSERT_EQ(rb.TryClaim(), nullptr);
+
+    auto view = rb.PeekN(4);
+    ASSERT_EQ(view.size(), 4u);
+    EXPECT_EQ(view[0].seq, 1u);
+    EXPECT_EQ(view[3].seq, 4u);
+    rb.Release(view.size());
+
+    claimed = rb.ClaimN(16);
+    ASSERT_EQ(claimed.size(), 1u);
+    claimed[0].seq = 8;
+    rb.CommitN(1);
+    claimed = rb.ClaimN(16);
+    ASSERT_EQ(claimed.size(), 3u);
+    claimed[0].seq = 9;
+    rb.CommitN(1);
+
+    uint64_t expected = 5;
+    while (!rb.Empty())
+    {
+        view = rb.PeekN(16);
+        for (const auto &message : view) { EXPECT_EQ(message.seq, expected++); }
+        rb.Release(view.size());
+    }
+    EXPECT_EQ(expected, 10u);
+}
+
+TEST(ByteRingBuffer, VariableRecordsAndWrap)
+{
+    ByteRingBuffer<64> rb;
+    auto bytes = [](std::string_view text) { return std::as_bytes(std::span(text.data(), text.size())); };
+    auto text = [](std::span<const std::byte> view) { return std::string(reinterpret_cast<const char *>(view.data()), view.size()); };
+
+    ASSERT_TRUE(rb.Peek().empty());
+    ASSERT_TRUE(rb.TryWrite(bytes("hello")));            // 12 -> 16 bytes
+    ASSERT_TRUE(rb.TryWrite(bytes("a longer record")));  // 19 -> 24 bytes
+    ASSERT_FALSE(rb.TryWrite(bytes(std::string(28, 'x'))));
+    ASSERT_EQ(rb.Size(), 40u);
+
+    ASSERT_EQ(text(rb.Peek()), "hello");
+    rb.Pop();
+
+    std::vector<std::string> seen;
+    auto collect = [&](std::span<const std::byte> view) { seen.push_back(text(view)); };
+    ASSERT_EQ(rb.ConsumeN(collect, 1), 1u);
+
+    // 24 bytes left before the end but this record needs 32, so the tail is
+    // skipped and the record starts at offset 0.
+    const std::string wrapped = "starts again at offset zero";
+    ASSERT_TRUE(rb.TryWrite(bytes(wrapped)));
+    ASSERT_EQ(rb.Size(), 24u + 32u);
+
+    ASSERT_EQ(rb.ConsumeN(collect), 1u);
+    ASSERT_EQ(seen, (std::vector<std::string>{ "a longer record", wrapped }));
+    ASSERT_TRUE(rb.Empty());
+    ASSERT_TRUE(rb.TryClaim(0).empty());
+    ASSERT_TRUE(rb.TryClaim(decltype(rb)::MaxPayload + 1).empty());
+}
+
+TEST(ByteRingBuffer, RecordsSurviveAcrossThreads)
+{
+    constexpr uint32_t N = 100000;
+    ByteRingBuffer<4096> rb;
+
+    std::thread producer([&rb]()
+        {
+            for (uint32_t i = 0; i < N; ++i)
+            {
+                const size_t length = 4 + i % 61;
+                std::span<std::byte> dst;
+                while ((dst = rb.TryClaim(length)).empty()) { std::this_thread::yield(); }
+
+                std::memset(dst.data(), static_cast<int>(i & 0xFF), length);
+                std::memcpy(dst.data(), &i, sizeof(i));
+                rb.Commit();
+            }
+        });
+
+    uint32_t expected = 0;
+    bool intact = true;
+    while (expected < N)
+    {
+        size_t n = rb.ConsumeN([&](std::span<const std::byte> view)
+            {
+                uint32_t seq;
+                std::memcpy(&seq, view.data(), sizeof(seq));
+                intact = intact && seq == expected && view.size() == 4 + expected % 61 &&
+                         (view.size() == 4 || view.back() == static_cast<std::byte>(expected & 0xFF));
+                ++expected;
+            }, 32);
+        if (n == 0) { std::this_thread::yield(); }
+    }
+    producer.join();
+
+    EXPECT_TRUE(intact);
+    EXPECT_TRUE(rb.Empty());
+}
+
+TEST(BroadcastRingBuffer, EveryConsumerSeesEveryItem)
+{
+    BroadcastRingBuffer<int, 4> rb;
+    auto &fast = rb.AddConsumer();
+    auto &slow = rb.AddConsumer();
+
+    for (int i = 0; i < 4; ++i) { EXPECT_TRUE(rb.TryPush(i)); }
+    EXPECT_FALSE(rb.TryPush(4));
+
+    std::vector<int> seen;
+    EXPECT_EQ(fast.PopN([&seen](const int &v) { seen.push_back(v); }), 4u);
+    EXPECT_EQ(seen, (std::vector<int>{ 0, 1, 2, 3 }));
+
+    // The slow consumer still holds every slot.
+    EXPECT_FALSE(rb.TryPush(4));
+    EXPECT_EQ(rb.Size(), 4u);
+
+    int value = -1;
+    EXPECT_TRUE(slow.TryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(rb.TryPush(4));
+    EXPECT_EQ(fast.Lag(), 1u);
+    EXPECT_EQ(slow.Lag(), 4u);
+}
+
+TEST(BroadcastRingBuffer, DependentConsumerTrailsUpstream)
+{
+    BroadcastRingBuffer<int, 8> rb;
+    auto &journal = rb.AddConsumer();
+    auto &drop_copy = rb.AddConsumer({ &journal });
+
+    const std::array<int, 3> items{ 1, 2, 3 };
+    EXPECT_EQ(rb.TryPushN(items), 3u);
+
+    int value = 0;
+    EXPECT_FALSE(drop_copy.TryPop(value));
+
+    EXPECT_TRUE(journal.TryPop(value));
+    EXPECT_TRUE(drop_copy.TryPop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(drop_copy.TryPop(value));
+
+    BroadcastRingBuffer<int, 8> other;
+    EXPECT_THROW(other.AddConsumer({ &journal }), std::invalid_argument);
+}
+
+TEST(BroadcastRingBuffer, ConsumerChainAcrossThreads)
+{
+    constexpr uint64_t N = 200000;
+    BroadcastRingBuffer<uint64_t, 256> rb;
+    auto &first = rb.AddConsumer();
+    auto &second = rb.AddConsumer({ &first });
+    auto &independent = rb.AddConsumer();
+
+    auto drain = [](auto &consumer, const auto &upstream, bool &in_order)
+        {
+            uint64_t expected = 0;
+            while (expected < N)
+            {
+                size_t n = consumer.PopN([&](const uint64_t &v)
+                    {
+                        in_order = in_order && v == expected && (!upstream || upstream->Sequence() > v);
+                        ++expected;
+                    }, 64);
+                if (n == 0) { std::this_thread::yield(); }
+            }
+        };
+
+    using Upstream = const BroadcastRingBuffer<uint64_t, 256>::Consumer *;
+    bool first_ok = true;
+    bool second_ok = true;
+    bool independent_ok = true;
+    std::thread t1([&]() { drain(first, Upstream{ nullptr }, first_ok); });
+    std::thread t2([&]() { drain(second, Upstream{ &first }, second_ok); });
+    std::thread t3([&]() { drain(independent, Upstream{ nullptr }, independent_ok); });
+
+    for (uint64_t i = 0; i < N; ++i)
+    {
+        while (!rb.TryPush(i)) { std::this_thread::yield(); }
+    }
+
+    t1.join();
+    t2.join();
+    t3.join();
+
+    EXPECT_TRUE(first_ok);
+    EXPECT_TRUE(second_ok);
+    EXPECT_TRUE(independent_ok);
+    EXPECT_TRUE(rb.Empty());
+}
+
+TEST(WaitStrategy, ParkedConsumerWakesOnNotify)
+{
+    SPSCRingBuffer<int, 16> rb;
+    WaitSignal signal;
+
+    WaitConfig config;
+    config.mode = WaitMode::SpinPark;
+    config.spin_iterations = 4;
+    config.yield_iterations = 4;
+
+    int received = 0;
+    std::thread consumer([&]()
+        {
+            IdleWaiter waiter(config, &signal);
+            while (received < 100)
+            {
+                if (rb.PopN([&received](int &) { ++received; }) == 0) { waiter.Idle(); continue; }
+                waiter.Reset();
+            }
+        });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        while (!rb.TryPush(i)) { std::this_thread::yield(); }
+        signal.Notify();
+        if (i % 10 == 0) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+    }
+
+    consumer.join();
+    EXPECT_EQ(received, 100);
+}
+
+TEST(HugePageAllocator, BacksRingsAndReportsBacking)
+{
+    struct Line { std::array<uint64_t, 8> words; };
+
+    // 2 MiB of slots is large enough to be offered huge pages.
+    SPSCRingBuffer<Line, 32768, HugePageAllocator<Line>> large;
+    const HugePageStats &stats = large.GetAllocator().Stats();
+    EXPECT_NE(stats.backing.load(), PageBacking::None);
+    EXPECT_TRUE(stats.prefaulted.load());
+    EXPECT_EQ(stats.mapped_bytes.load() % HugePageAllocator<Line>::HugePageSize, 0u);
+
+    EXPECT_TRUE(large.TryPush(Line{ { 1, 2, 3, 4, 5, 6, 7, 8 } }));
+    ASSERT_NE(large.Peek(), nullptr);
+    EXPECT_EQ(large.Peek()->words[7], 8u);
+    EXPECT_TRUE(large.TryPop());
+
+    // Small buffers are page-rounded and never huge.
+    HugePageAllocator<int> small;
+    int *p = small.allocate(16);
+    EXPECT_EQ(small.Backing(), PageBacking::Regular);
+    small.deallocate(p, 16);
+
+    // Rebinding shares the stats, as MPMCRingBuffer's slot allocator does.
+    MPMCRingBuffer<int, 64, HugePageAllocator<int>> mpmc;
+    EXPECT_EQ(mpmc.GetAllocator().Backing(), PageBacking::Regular);
+    EXPECT_TRUE(mpmc.TryPush(7));
+}
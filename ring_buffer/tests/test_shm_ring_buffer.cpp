@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "ring_buffer/shm_ring_buffer.h"
+
+using namespace hft;
+
+namespace
+{
+    std::string SegmentName(const char *test)
+    {
+        return std::string("hft_test_") + test + "_" + std::to_string(::getpid());
+    }
+}
+
+TEST(ShmSPSCRingBuffer, ProducerAndConsumerShareSegment)
+{
+    using Ring = ShmSPSCRingBuffer<uint64_t, 8>;
+    const std::string name = SegmentName("share");
+    Ring::Unlink(name);
+
+    auto producer = Ring::Create(name, ShmRole::Producer);
+    auto consumer = Ring::Attach(name, ShmRole::Consumer);
+
+    for (uint64_t i = 0; i < 8; ++i) { EXPECT_TRUE(producer.TryPush(i)); }
+    EXPECT_FALSE(producer.TryPush(8));
+    EXPECT_EQ(consumer.Size(), 8u);
+
+    std::vector<uint64_t> seen;
+    EXPECT_EQ(consumer.PopN([&seen](const uint64_t &v) { seen.push_back(v); }), 8u);
+    EXPECT_EQ(seen, (std::vector<uint64_t>{ 0, 1, 2, 3, 4, 5, 6, 7 }));
+    EXPECT_TRUE(producer.TryPush(8));
+    EXPECT_EQ(producer.ProducerEpoch(), 1u);
+
+    // Layout is checked against the template arguments, and a live
+    // producer cannot be displaced.
+    EXPECT_THROW((ShmSPSCRingBuffer<uint64_t, 16>::Attach(name, ShmRole::Consumer)), std::runtime_error);
+    EXPECT_THROW((ShmSPSCRingBuffer<uint32_t, 8>::Attach(name, ShmRole::Consumer)), std::runtime_error);
+    EXPECT_THROW(Ring::Attach(name, ShmRole::Producer), std::runtime_error);
+
+    EXPECT_TRUE(Ring::Unlink(name));
+}
+
+TEST(ShmSPSCRingBuffer, SlotsHonourOverAlignedElements)
+{
+    struct alignas(256) Wide
+    {
+        uint64_t value;
+    };
+
+    using Ring = ShmSPSCRingBuffer<Wide, 4>;
+    const std::string name = SegmentName("aligned");
+    Ring::Unlink(name);
+
+    auto producer = Ring::Create(name, ShmRole::Producer);
+    auto consumer = Ring::Attach(name, ShmRole::Consumer);
+
+    for (uint64_t i = 0; i < 4; ++i) { EXPECT_TRUE(producer.TryPush(Wide{ i })); }
+
+    uint64_t expected = 0;
+    EXPECT_EQ(consumer.PopN([&expected](const Wide &w)
+        {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(&w) % alignof(Wide), 0u);
+            EXPECT_EQ(w.value, expected++);
+        }), 4u);
+
+    EXPECT_TRUE(Ring::Unlink(name));
+}
+
+TEST(ShmSPSCRingBuffer, ProducerRestartResumesAfterCrash)
+{
+    using Ring = ShmSPSCRingBuffer<uint64_t, 64>;
+    const std::string name = SegmentName("restart");
+    Ring::Unlink(name);
+
+    auto consumer = Ring::Create(name, ShmRole::Consumer);
+
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        // Publish a few items, then die without releasing the role.
+        auto producer = Ring::Attach(name, ShmRole::Producer);
+        for (uint64_t i = 0; i < 5; ++i) { (void)producer.TryPush(i); }
+        ::_exit(0);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_EQ(consumer.ProducerEpoch(), 1u);
+
+    uint64_t value = 0;
+    ASSERT_TRUE(consumer.TryPop(value));
+    EXPECT_EQ(value, 0u);
+
+    auto producer = Ring::Attach(name, ShmRole::Producer);
+    EXPECT_EQ(consumer.ProducerEpoch(), 2u);
+    EXPECT_TRUE(producer.TryPush(100));
+
+    std::vector<uint64_t> seen;
+    while (consumer.PopN([&seen](const uint64_t &v) { seen.push_back(v); }) > 0) { }
+    EXPECT_EQ(seen, (std::vector<uint64_t>{ 1, 2, 3, 4, 100 }));
+
+    EXPECT_TRUE(Ring::Unlink(name));
+}
@@ -0,0 +1,169 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <cstdlib>
+#include <cstdint>
+
+#include "common/types.h"
+#include "slab_alloc/slab_alloc.h"
+#include "slab_alloc/slab_pool.h"
+#include "ring_buffer/ring_buffer.h"
+
+using namespace hft;
+
+namespace
+{
+    // Shared by every benchmark thread, like an allocator owned by a
+    // pipeline and used from its worker threads.
+    SlabAlloc g_slab;
+
+    constexpr int BatchSize = 64;
+
+    SPSCRingBuffer<void *, 1024> g_handoff;
+
+    struct MallocPolicy
+    {
+        static void *Allocate(size_t bytes) { return std::malloc(bytes); }
+        static void Deallocate(void *p) { std::free(p); }
+    };
+
+    struct SlabPolicy
+    {
+        static void *Allocate(size_t bytes) { return g_slab.Allocate(bytes); }
+        static void Deallocate(void *p) { g_slab.Deallocate(p); }
+    };
+}
+
+// One allocation immediately freed: the best case for any front-end cache.
+template <typename Policy>
+static void BM_AllocFree(benchmark::State &state)
+{
+    const size_t bytes = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        void *p = Policy::Allocate(bytes);
+        benchmark::DoNotOptimize(p);
+        Policy::Deallocate(p);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// A batch held live before being freed in allocation order, so the
+// allocator has to move objects in and out of its per-thread caches.
+template <typename Policy>
+static void BM_AllocFreeBatch(benchmark::State &state)
+{
+    const size_t bytes = static_cast<size_t>(state.range(0));
+    void *live[BatchSize];
+    for (auto _ : state)
+    {
+        for (int i = 0; i < BatchSize; ++i)
+        {
+            live[i] = Policy::Allocate(bytes);
+            benchmark::DoNotOptimize(live[i]);
+        }
+        for (int i = 0; i < BatchSize; ++i)
+        {
+            Policy::Deallocate(live[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+
+BENCHMARK_TEMPLATE(BM_AllocFree, MallocPolicy)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_AllocFree, SlabPolicy)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_AllocFreeBatch, MallocPolicy)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_AllocFreeBatch, SlabPolicy)->Arg(16)->Arg(64)->Arg(256)->ThreadRange(1, 8);
+
+// Producer/consumer handoff: thread 0 allocates and passes each object
+// through an SPSC ring, thread 1 frees it, as the parser and engine do with
+// requests. Every free is a cross-thread free.
+template <typename Policy>
+static void BM_CrossThreadFree(benchmark::State &state)
+{
+    const size_t bytes = static_cast<size_t>(state.range(0));
+    if (state.thread_index() == 0)
+    {
+        for (auto _ : state)
+        {
+            void *p = Policy::Allocate(bytes);
+            benchmark::DoNotOptimize(p);
+            while (!g_handoff.TryPush(p)) { std::this_thread::yield(); }
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            while (g_handoff.PopN([](void *p) { Policy::Deallocate(p); }, 1) == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_CrossThreadFree, MallocPolicy)->Arg(64)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CrossThreadFree, SlabPolicy)->Arg(64)->Threads(2)->UseRealTime();
+
+namespace
+{
+    constexpr size_t LiveObjects = 4096;
+
+    template <typename T>
+    T MakeValue(uint64_t i)
+    {
+        T value{ };
+        if constexpr (std::is_same_v<T, Order>)
+        {
+            value.id = i;
+            value.quantity = 100;
+        }
+        else
+        {
+            value.order.id = i;
+            value.order.quantity = 100;
+        }
+        return value;
+    }
+}
+
+// Churn over a fixed set of live objects, the way resting orders or
+// in-flight requests come and go: each iteration replaces one slot with a
+// fresh object and destroys the one it held.
+template <typename T>
+static void BM_MakeUniqueChurn(benchmark::State &state)
+{
+    std::vector<std::unique_ptr<T>> live(LiveObjects);
+    uint64_t i = 0;
+    for (auto _ : state)
+    {
+        live[i % LiveObjects] = std::make_unique<T>(MakeValue<T>(i));
+        benchmark::DoNotOptimize(live[i % LiveObjects].get());
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T>
+static void BM_SlabPoolChurn(benchmark::State &state)
+{
+    SlabAlloc alloc;
+    SlabPool<T> pool(alloc);
+    std::vector<SlabPtr<T>> live(LiveObjects);
+    uint64_t i = 0;
+    for (auto _ : state)
+    {
+        live[i % LiveObjects] = pool.MakeUnique(MakeValue<T>(i));
+        benchmark::DoNotOptimize(live[i % LiveObjects].get());
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_MakeUniqueChurn, Order);
+BENCHMARK_TEMPLATE(BM_SlabPoolChurn, Order);
+BENCHMARK_TEMPLATE(BM_MakeUniqueChurn, OrderRequest);
+BENCHMARK_TEMPLATE(BM_SlabPoolChurn, OrderRequest);
@@ -1,79 +1,172 @@
- /* This is a very bad attempt at a slab allocator!
-  * and currently not being used throughout the rest of the pipeline. 
-  * Needs a full rewrite, better sizing logic, metadata layout, lifecycle
-  * handling, real policy and per-cache behavior.
-  * Cache sizing needs to consider calculating object size, alignment, order,
-  * and the number of objects per slab for every cache. 
-  * Pick the smallest amount of pages that fits at least min num of objs(1?)
-  * Real slub uses an order calculation path that tries to fit a number of
-  * objects per slab and adjusts alignment and offset as needed. something similar
-  * should exist here, compute pages_needed, slab_bytes, usable space after metadata,
-  * and objects_per_slab. min_partial and max_partial should also depend
-  * on object size, like slub's ilog2(size)/2 heuristic, to balance memory usage and
-  * freq allocations. Alignment should be handled correctly, both for the slab and each object.
-  * Proper alignment, something like aligning objects to alignof(T) or std::max_align_t
-  * offset might be needed if metadata ends @ middle. Smaller objects shouldn;t be cache(line) aligned unless requested.
-  * Metadata separation is missing. The slab header should be a fixed offset that allows recovery from any obj ptr. 
-  * Use power of two sizes? Easy to mask the ptr and get the base.
-  * Allocations should pop from the slab freelist. If the slab is empty, refill from the partial list.
-  * If no partial slabs remain, allocate a new slab. Free pushes objects back to the freelist. 
-  * When a slab transitions from full to partial, move it between the lists. Fully empty slabs should be reclaimed. 
-  * Enforce min_partial and max_partial per cache, freeing or caching slabs beyond that range.
-  * Allocations should consider the 64kb Windows reservation granularity.
-  * Slabs smaller than that should still be reserved from a larger aligned region.
-  * Use MEM_RESERVE for virtual address space, commit pages (MEM_COMMIT) lazily as slabs are populated.
-  * Reserving aligned blocks per cache is cheap and gives predictable slab alignment.
-  * Should also track which slabs are committed and which are still reserved, to reclaim memory later.
-  * Thread-local caches should replace the global path for most allocations.
-  * Each thread(pinned to a diff core) keeps its own cache storage, pseudo per-cpu like linux.
-  * Thread-local storage would hold the active slab and a small local list of partials.
-  * Allocations hit the local freelist directly, if empty, it refills from the global
-  * cache partial list. When the local cache gets too many empty slabs, it should flush
-  * them back. this should give better locality in the lockless path.
-  * Add destruction and merging. When a cache is destroyed,
-  * all its slabs should be walked and freed, and empty slabs merged or released back
-  * to the OS. Merging identical caches (same size/alignment) would also be useful to reduce duplication.
-  * Add cache aliasing so small objects from different caches wont fight for the same cache lines.
-  * Slub uses color offsetting to reduce that. A lightweight slab stats struct could track allocation counts,
-  * frees, and transitions between full/partial/empty
-  */
+/* Slab allocator: per-size caches of slab-aligned 4 KiB slabs carved from
+ * reserved regions, with per-thread magazines in front (see below).
+ * Still open:
+ * Double-free detection and bounds checking on deallocate.
+ * Cache colouring: offset the first object per slab so small objects from
+ * different slabs don't all fight for the same cache lines, like slub's
+ * colour offsetting.
+ * Cache merging: caches with the same size/alignment could share slabs to
+ * reduce duplication.
+ * Slab size/order calculation: every cache uses one page per slab. Real slub
+ * picks an order per cache so a slab fits a minimum number of objects at an
+ * acceptable waste, computing pages_needed, slab_bytes, usable space after
+ * metadata and objects_per_slab, and adjusts alignment and offset as needed.
+ * Objects are only pointer aligned; alignof(T) or max_align_t requests
+ * should be honoured per cache.
+ */
 
 #ifndef SLAB_ALLOC_H
 #define SLAB_ALLOC_H
 
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <new>
+#include <utility>
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cstdint>
 
-#define WIN32_LEAN_AND_MEAN
-#define NOMINMAX
-#include <Windows.h>
+#include "slab_alloc/slab_arena.h"
 
 #define SLAB_ALLOC_DEBUG
 
 namespace hft
 {
     // TODO(vss): Double free is not detected and causes silent corruption
-    // No thread safety
-    // Empty slabs are never returned to OS
     // No bounds checking on deallocate(assumes valid slab pointers)
 
+    // Snapshot of one cache, safe to take from any thread (e.g. a monitor)
+    // while others allocate. allocs/frees count calls into the allocator,
+    // depot_trips the slow-path visits that took the cache lock, and the
+    // to_* counters slab transitions between the lists.
+    struct SlabCacheStats
+    {
+        size_t object_size{ 0 };
+        size_t min_partial{ 0 };
+        size_t max_partial{ 0 };
+
+        uint64_t allocs{ 0 };
+        uint64_t frees{ 0 };
+        uint64_t depot_trips{ 0 };
+
+        uint64_t to_full{ 0 };
+        uint64_t to_partial{ 0 };
+        uint64_t to_empty{ 0 };
+        uint64_t slabs_created{ 0 };
+        uint64_t slabs_released{ 0 };
+
+        size_t full_slabs{ 0 };
+        size_t partial_slabs{ 0 };
+        size_t empty_slabs{ 0 };
+        size_t bytes_committed{ 0 };
+    };
+
+    // Thread-safe front end in three layers, after Bonwick's magazines:
+    //  - each thread keeps a loaded and a previous magazine (a small stack of
+    //    free objects) per size class; allocate pops, free pushes, and both
+    //    touch only thread-local memory while the magazines last
+    //  - a per-cache depot of full and empty magazines that threads trade
+    //    with when both of theirs run dry or fill up
+    //  - the slab layer (partial/full lists and the arena) behind the same
+    //    per-cache lock, used only to refill or drain whole magazines
+    // Threads register on first use; a thread that exits leaves its
+    // magazines to the next thread that gets the same id, or can hand them
+    // back early with FlushThreadCache().
+    //
+    // Slabs whose objects are all free sit on the cache's empty list. Each
+    // cache keeps min_partial of them ready; once more than max_partial
+    // pile up, the surplus goes back to the arena, which decommits it.
+    // Both bounds follow SLUB's ilog2(size)/2 heuristic, so caches of
+    // larger objects keep more slabs around.
+    //
+    // Every slab has a home: the thread that last refilled from it. A free
+    // from any other thread is pushed onto the home thread's lock-free
+    // remote stack for that size class (one CAS, no lock), and the home
+    // thread takes the whole stack with one exchange the next time its
+    // magazines run dry. Objects handed from a producer thread to a
+    // consumer thread thus flow straight back to the producer.
     class SlabAlloc
     {
         struct Cache;
+        struct ThreadCache;
 
         struct Slab
         {
             Slab *next;
             Slab *prev;
             Cache *owner;
+            std::atomic<ThreadCache *> home;
             size_t total_slots;
             size_t free_slots;
             void *free_list;
         };
 
+        struct Magazine
+        {
+            static constexpr uint32_t Capacity = 64;
+
+            Magazine *next{ nullptr };
+            uint32_t count{ 0 };
+            void *objects[Capacity];
+
+            bool Empty() const noexcept { return count == 0; }
+            bool Full() const noexcept { return count == Capacity; }
+            void *Pop() noexcept { return objects[--count]; }
+            void Push(void *obj) noexcept { objects[count++] = obj; }
+        };
+
+        struct MagazineList
+        {
+            Magazine *head{ nullptr };
+            size_t count{ 0 };
+
+            void Push(Magazine *m) noexcept
+            {
+                m->next = head;
+                head = m;
+                ++count;
+            }
+
+            Magazine *Pop() noexcept
+            {
+                Magazine *m = head;
+                if (m)
+                {
+                    head = m->next;
+                    m->next = nullptr;
+                    --count;
+                }
+                return m;
+            }
+        };
+
+        // Written under the cache lock, read from anywhere.
+        struct CacheCounters
+        {
+            std::atomic<uint64_t> to_full{ 0 };
+            std::atomic<uint64_t> to_partial{ 0 };
+            std::atomic<uint64_t> to_empty{ 0 };
+            std::atomic<uint64_t> slabs_created{ 0 };
+            std::atomic<uint64_t> slabs_released{ 0 };
+            std::atomic<size_t> full_slabs{ 0 };
+            std::atomic<size_t> partial_slabs{ 0 };
+            std::atomic<size_t> empty_slabs{ 0 };
+            std::atomic<size_t> bytes_committed{ 0 };
+
+            // Slow-path visits that took the cache lock.
+            std::atomic<uint64_t> depot_trips{ 0 };
+
+            // Calls made without a thread cache.
+            std::atomic<uint64_t> allocs{ 0 };
+            std::atomic<uint64_t> frees{ 0 };
+        };
+
         struct Cache
         {
             Cache(size_t obj_size, size_t slab_size)
@@ -81,47 +174,128 @@ namespace hft
                 , slab_size(slab_size)
                 , partial(nullptr)
                 , full(nullptr)
+                , empty(nullptr)
+                , arena(slab_size)
             {
+                // SLUB: ilog2(size) / 2, clamped.
+                min_partial = std::clamp<size_t>(std::bit_width(obj_size) / 2, MinPartial, MaxPartial);
+                max_partial = 2 * min_partial;
+            }
+
+            ~Cache()
+            {
+                for (MagazineList *list : { &full_magazines, &empty_magazines })
+                {
+                    while (Magazine *m = list->Pop()) { delete m; }
+                }
             }
 
             size_t obj_size;
             size_t slab_size;
+            size_t min_partial;
+            size_t max_partial;
             Slab *partial;
             Slab *full;
+            Slab *empty;
+            SlabArena arena;
+            CacheCounters counters;
+
+            // Guards the depot and the slab layer.
+            std::mutex lock;
+            MagazineList full_magazines;
+            MagazineList empty_magazines;
         };
 
-    public:
+        struct MagazinePair
+        {
+            Magazine *loaded{ nullptr };
+            Magazine *previous{ nullptr };
+        };
 
-        SlabAlloc()
+        static constexpr size_t MaxClasses = 4096 / sizeof(void *);
+        static constexpr size_t MinPartial = 1;
+        static constexpr size_t MaxPartial = 8;
+
+        // Single writer (the owning thread), so plain load/store is enough
+        // and the fast path takes no RMW.
+        struct OpCounts
         {
-            m_default_slab_size = 4096;
+            std::atomic<uint64_t> allocs{ 0 };
+            std::atomic<uint64_t> frees{ 0 };
+        };
+
+        static void Bump(std::atomic<uint64_t> &counter) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         }
 
-        ~SlabAlloc()
+        struct ThreadCache
         {
-            for (auto &entry : m_cache)
+            std::thread::id owner;
+            std::array<MagazinePair, MaxClasses> magazines{ };
+
+            // Remote frees already taken off `remote`, linked through the
+            // objects. Owner only.
+            std::array<void *, MaxClasses> reclaimed{ };
+            std::array<OpCounts, MaxClasses> counts{ };
+
+            // Objects freed by other threads into slabs homed here; pushed
+            // by any thread, emptied only by the owner.
+            alignas(64) std::array<std::atomic<void *>, MaxClasses> remote{ };
+
+            void PushRemote(size_t cls, void *obj) noexcept
             {
-                Cache *cache = entry.second.get();
-                if (!cache) continue;
+                void *head = remote[cls].load(std::memory_order_relaxed);
+                do
+                {
+                    *reinterpret_cast<void **>(obj) = head;
+                } while (!remote[cls].compare_exchange_weak(head, obj,
+                    std::memory_order_release, std::memory_order_relaxed));
+            }
 
-                auto free_list = [](Slab *head)
-                    {
-                        Slab *slab = head;
-                        while (slab)
-                        {
-                            Slab *next = slab->next;
-                            VirtualFree(reinterpret_cast<void *>(slab), 0, MEM_RELEASE);
-                            slab = next;
-                        }
-                    };
+            void *PopReclaimed(size_t cls) noexcept
+            {
+                void *obj = reclaimed[cls];
+                if (!obj)
+                {
+                    // The consumer takes the whole stack at once, so there
+                    // is no ABA on the pushers' side.
+                    obj = remote[cls].exchange(nullptr, std::memory_order_acquire);
+                    if (!obj) { return nullptr; }
+                }
+                reclaimed[cls] = *reinterpret_cast<void **>(obj);
+                return obj;
+            }
 
-                free_list(cache->partial);
-                free_list(cache->full);
+            ~ThreadCache()
+            {
+                for (auto &pair : magazines)
+                {
+                    delete pair.loaded;
+                    delete pair.previous;
+                }
             }
+        };
 
+    public:
+
+        SlabAlloc()
+        {
+            m_default_slab_size = 4096;
+        }
+
+        // Each cache's arena releases its reserved regions, and with them
+        // every slab. Thread caches go first so no magazine outlives its
+        // cache.
+        ~SlabAlloc()
+        {
+            m_thread_caches.clear();
             m_cache.clear();
         }
 
+        SlabAlloc(const SlabAlloc &) = delete;
+        SlabAlloc &operator=(const SlabAlloc &) = delete;
+
 #ifdef SLAB_ALLOC_DEBUG
         size_t DebugAlignedSize(size_t bytes) const noexcept
         {
@@ -140,7 +314,8 @@ namespace hft
                 return usable / aligned;
             }
 
-            Slab *slab = cache->partial ? cache->partial : cache->full;
+            std::lock_guard guard(cache->lock);
+            Slab *slab = cache->partial ? cache->partial : (cache->full ? cache->full : cache->empty);
             return slab ? slab->total_slots : 0;
         }
 
@@ -179,49 +354,83 @@ namespace hft
                     return n;
                 };
 
-            size_t result = count_list(cache->partial) + count_list(cache->full);
+            std::lock_guard guard(cache->lock);
+            size_t result = count_list(cache->partial) + count_list(cache->full) + count_list(cache->empty);
             return result;
         }
 #endif
 
-        void *Allocate(uint64_t bytes)
+        // An object size resolved to its cache once, for callers that
+        // allocate the same size over and over (see SlabPool). Stays valid
+        // for the allocator's lifetime.
+        class SizeClass
+        {
+        public:
+            SizeClass() = default;
+
+            explicit operator bool() const noexcept { return m_cache != nullptr; }
+            size_t ObjectSize() const noexcept { return m_cache ? m_cache->obj_size : 0; }
+
+        private:
+            friend class SlabAlloc;
+
+            SizeClass(Cache *cache, size_t index) noexcept
+                : m_cache(cache)
+                , m_index(index)
+            { }
+
+            Cache *m_cache{ nullptr };
+            size_t m_index{ 0 };
+        };
+
+        // Empty if `bytes` is zero or does not fit in a slab.
+        SizeClass BindSizeClass(uint64_t bytes)
         {
             if (bytes == 0)
             {
-                return nullptr;
+                return { };
             }
 
             size_t aligned_size = AlignUp(bytes, sizeof(void *));
             aligned_size = std::max(aligned_size, sizeof(void *));
+            if (aligned_size > MaxObjectSize())
+            {
+                return { };
+            }
 
             Cache *cache = FindCache(aligned_size);
             if (!cache)
             {
                 cache = CreateCache(aligned_size);
             }
+            return SizeClass(cache, ClassIndex(aligned_size));
+        }
 
-            if (!cache->partial)
-            {
-                Slab *slab = CreateSlab(cache);
-                if (!slab)
-                {
-                    return nullptr;
-                }
+        void *Allocate(uint64_t bytes)
+        {
+            return Allocate(BindSizeClass(bytes));
+        }
 
-                InsertSlabIntoList(&cache->partial, slab);
+        void *Allocate(SizeClass size_class)
+        {
+            if (!size_class)
+            {
+                return nullptr;
             }
 
-            Slab *slab = cache->partial;
-            void *obj = PopFromSlab(slab);
-            assert(obj != nullptr);
-
-            if (!slab->free_slots)
+            ThreadCache *tc = LocalThreadCache();
+            if (!tc)
             {
-                RemoveSlabFromList(&cache->partial, slab);
-                InsertSlabIntoList(&cache->full, slab);
+                return nullptr;
             }
 
-            return obj;
+            MagazinePair &pair = tc->magazines[size_class.m_index];
+            void *p = (pair.loaded && !pair.loaded->Empty())
+                ? pair.loaded->Pop()
+                : AllocateSlow(size_class.m_cache, tc, pair);
+
+            if (p) { Bump(tc->counts[size_class.m_index].allocs); }
+            return p;
         }
 
         void Deallocate(void *p)
@@ -231,70 +440,510 @@ namespace hft
                 return;
             }
 
-            size_t slab_size = m_default_slab_size;
-            uintptr_t x = reinterpret_cast<uintptr_t>(p);
-            uintptr_t base = x & ~(slab_size - 1);
-            Slab *slab = reinterpret_cast<Slab *>(base);
-
+            Slab *slab = SlabFromPtr(p);
             assert(slab->owner != nullptr);
             Cache *cache = slab->owner;
-            bool was_full = (slab->free_slots == 0);
 
-            PushToSlab(slab, p);
+            ThreadCache *tc = LocalThreadCache();
+            if (!tc)
+            {
+                cache->counters.frees.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard guard(cache->lock);
+                ReturnToSlab(cache, slab, p);
+                return;
+            }
 
-            if (was_full)
+            const size_t cls = ClassIndex(cache->obj_size);
+            Bump(tc->counts[cls].frees);
+            ThreadCache *home = slab->home.load(std::memory_order_acquire);
+            if (home && home != tc)
             {
-                RemoveSlabFromList(&cache->full, slab);
-                InsertSlabIntoList(&cache->partial, slab);
+                home->PushRemote(cls, p);
+                return;
             }
 
-            // TODO(vss): Handle completely empty slabs so we dont keep them forever,
-            // simple policy could be: if slab->free_slots == slab->total_slots
-            // keep N empty slabs cached or VirtualFree them all
+            MagazinePair &pair = tc->magazines[cls];
+            if (pair.loaded && !pair.loaded->Full())
+            {
+                pair.loaded->Push(p);
+                return;
+            }
+
+            DeallocateSlow(cache, pair, p);
+        }
+
+        // Hands every object cached by the calling thread, including remote
+        // frees waiting for it, back to the slab layer. Worth calling before
+        // a worker thread exits; remote frees that arrive afterwards wait
+        // until the thread's cache is adopted or the allocator is destroyed.
+        void FlushThreadCache()
+        {
+            ThreadCache *tc = LocalThreadCache();
+            if (!tc)
+            {
+                return;
+            }
+
+            for (size_t cls = 0; cls < MaxClasses; ++cls)
+            {
+                Cache *cache = m_classes[cls].load(std::memory_order_acquire);
+                if (!cache)
+                {
+                    continue;
+                }
+
+                MagazinePair &pair = tc->magazines[cls];
+                std::lock_guard guard(cache->lock);
+                while (void *obj = tc->PopReclaimed(cls))
+                {
+                    ReturnToSlab(cache, SlabFromPtr(obj), obj);
+                }
+
+                for (Magazine *m : { pair.loaded, pair.previous })
+                {
+                    if (!m) continue;
+                    DrainMagazine(cache, m);
+                    cache->empty_magazines.Push(m);
+                }
+                pair = { };
+            }
+        }
+
+        // Returns what the depots hold to the slabs and releases every empty
+        // slab beyond each cache's min_partial, e.g. once a burst is over.
+        // Objects in thread magazines are untouched; see FlushThreadCache.
+        void Trim()
+        {
+            for (size_t cls = 0; cls < MaxClasses; ++cls)
+            {
+                Cache *cache = m_classes[cls].load(std::memory_order_acquire);
+                if (!cache)
+                {
+                    continue;
+                }
+
+                std::lock_guard guard(cache->lock);
+                while (Magazine *m = cache->full_magazines.Pop())
+                {
+                    DrainMagazine(cache, m);
+                    delete m;
+                }
+                while (Magazine *m = cache->empty_magazines.Pop())
+                {
+                    delete m;
+                }
+                ReleaseEmptySlabs(cache, cache->min_partial);
+            }
+        }
+
+        // Zeroed stats if no cache serves `bytes` yet.
+        SlabCacheStats CacheStats(uint64_t bytes) const
+        {
+            size_t aligned_size = std::max(AlignUp(bytes, sizeof(void *)), sizeof(void *));
+            const Cache *cache = FindCache(aligned_size);
+            return cache ? Snapshot(*cache) : SlabCacheStats{ };
+        }
+
+        // One entry per cache, smallest objects first.
+        std::vector<SlabCacheStats> Stats() const
+        {
+            std::vector<SlabCacheStats> stats;
+            for (size_t cls = 0; cls < MaxClasses; ++cls)
+            {
+                if (const Cache *cache = m_classes[cls].load(std::memory_order_acquire))
+                {
+                    stats.push_back(Snapshot(*cache));
+                }
+            }
+            return stats;
         }
 
     private:
+        // Full magazines parked in a depot beyond this are drained back
+        // into their slabs.
+        static constexpr size_t DepotFullLimit = 8;
+
         size_t m_default_slab_size = 4096;
         std::unordered_map<size_t, std::unique_ptr<Cache>> m_cache;
+        std::array<std::atomic<Cache *>, MaxClasses> m_classes{ };
+        std::mutex m_cache_mutex;
+
+        std::vector<std::unique_ptr<ThreadCache>> m_thread_caches;
+        mutable std::mutex m_thread_cache_mutex;
+        const uint64_t m_id{ NextAllocatorId() };
 
         static inline size_t AlignUp(size_t n, size_t a) { return (n + (a - 1)) & ~(a - 1); }
 
+        static constexpr size_t ClassIndex(size_t aligned_size) noexcept
+        {
+            return aligned_size / sizeof(void *) - 1;
+        }
+
+        size_t MaxObjectSize() const noexcept
+        {
+            return m_default_slab_size - AlignUp(sizeof(Slab), sizeof(void *));
+        }
+
+        Slab *SlabFromPtr(void *p) const noexcept
+        {
+            uintptr_t x = reinterpret_cast<uintptr_t>(p);
+            uintptr_t base = x & ~(static_cast<uintptr_t>(m_default_slab_size) - 1);
+            return reinterpret_cast<Slab *>(base);
+        }
+
+        SlabCacheStats Snapshot(const Cache &cache) const
+        {
+            const CacheCounters &c = cache.counters;
+            SlabCacheStats stats;
+            stats.object_size = cache.obj_size;
+            stats.min_partial = cache.min_partial;
+            stats.max_partial = cache.max_partial;
+            stats.allocs = c.allocs.load(std::memory_order_relaxed);
+            stats.frees = c.frees.load(std::memory_order_relaxed);
+            stats.depot_trips = c.depot_trips.load(std::memory_order_relaxed);
+            stats.to_full = c.to_full.load(std::memory_order_relaxed);
+            stats.to_partial = c.to_partial.load(std::memory_order_relaxed);
+            stats.to_empty = c.to_empty.load(std::memory_order_relaxed);
+            stats.slabs_created = c.slabs_created.load(std::memory_order_relaxed);
+            stats.slabs_released = c.slabs_released.load(std::memory_order_relaxed);
+            stats.full_slabs = c.full_slabs.load(std::memory_order_relaxed);
+            stats.partial_slabs = c.partial_slabs.load(std::memory_order_relaxed);
+            stats.empty_slabs = c.empty_slabs.load(std::memory_order_relaxed);
+            stats.bytes_committed = c.bytes_committed.load(std::memory_order_relaxed);
+
+            const size_t cls = ClassIndex(cache.obj_size);
+            std::lock_guard guard(m_thread_cache_mutex);
+            for (const auto &tc : m_thread_caches)
+            {
+                stats.allocs += tc->counts[cls].allocs.load(std::memory_order_relaxed);
+                stats.frees += tc->counts[cls].frees.load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+
+        static uint64_t NextAllocatorId() noexcept
+        {
+            static std::atomic<uint64_t> next{ 1 };
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
         Cache *FindCache(size_t obj_size) const
         {
-            auto it = m_cache.find(obj_size);
-            return (it != m_cache.end()) ? it->second.get() : nullptr;
+            if (obj_size == 0 || ClassIndex(obj_size) >= MaxClasses) return nullptr;
+            return m_classes[ClassIndex(obj_size)].load(std::memory_order_acquire);
         }
 
         Cache *CreateCache(size_t obj_size)
         {
+            std::lock_guard guard(m_cache_mutex);
+            if (Cache *existing = FindCache(obj_size))
+            {
+                return existing;
+            }
+
             auto [it, _] = m_cache.emplace(
                 obj_size, std::make_unique<Cache>(obj_size, m_default_slab_size));
+            m_classes[ClassIndex(obj_size)].store(it->second.get(), std::memory_order_release);
             return it->second.get();
         }
 
-        Slab *CreateSlab(Cache *cache)
+        // Cached per thread and keyed by allocator id, so an allocator
+        // created at a recycled address never sees a stale thread cache.
+        ThreadCache *LocalThreadCache()
         {
-            size_t slab_size = cache->slab_size;
-            void *memory = VirtualAlloc(nullptr, slab_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
-            if (!memory)
+            struct Local
             {
-                return nullptr;
+                uint64_t allocator_id{ 0 };
+                ThreadCache *cache{ nullptr };
+            };
+            thread_local Local local;
+
+            if (local.allocator_id == m_id) { return local.cache; }
+
+            ThreadCache *tc = FindOrRegisterThreadCache();
+            if (tc) { local = { m_id, tc }; }
+            return tc;
+        }
+
+        ThreadCache *FindOrRegisterThreadCache()
+        {
+            // A recycled thread id means the previous owner has exited, so
+            // its magazines can be adopted as they are.
+            const auto self = std::this_thread::get_id();
+            std::lock_guard guard(m_thread_cache_mutex);
+            for (auto &tc : m_thread_caches)
+            {
+                if (tc->owner == self) { return tc.get(); }
             }
 
-            Slab *slab = reinterpret_cast<Slab *>(memory);
-            slab->prev = nullptr;
-            slab->next = nullptr;
-            slab->owner = cache;
+            auto tc = std::unique_ptr<ThreadCache>(new (std::nothrow) ThreadCache());
+            if (!tc) { return nullptr; }
+            tc->owner = self;
+            m_thread_caches.push_back(std::move(tc));
+            return m_thread_caches.back().get();
+        }
+
+        // Bonwick's exchange: previous is always either full or empty, so
+        // a thread working around one magazine boundary just swaps the two
+        // and only goes to the depot when both are exhausted.
+        void *AllocateSlow(Cache *cache, ThreadCache *tc, MagazinePair &pair)
+        {
+            if (pair.previous && !pair.previous->Empty())
+            {
+                std::swap(pair.loaded, pair.previous);
+                return pair.loaded->Pop();
+            }
+
+            if (void *obj = tc->PopReclaimed(ClassIndex(cache->obj_size)))
+            {
+                return obj;
+            }
+
+            std::lock_guard guard(cache->lock);
+            cache->counters.depot_trips.fetch_add(1, std::memory_order_relaxed);
+            if (Magazine *full = cache->full_magazines.Pop())
+            {
+                // Both are empty: the older one goes back to the depot and
+                // the newer one stays as previous to absorb frees.
+                if (pair.loaded)
+                {
+                    if (pair.previous) { cache->empty_magazines.Push(pair.previous); }
+                    pair.previous = pair.loaded;
+                }
+                pair.loaded = full;
+                return pair.loaded->Pop();
+            }
+
+            if (!pair.loaded)
+            {
+                pair.loaded = TakeEmptyMagazine(cache);
+                if (!pair.loaded) { return nullptr; }
+            }
+
+            RefillMagazine(cache, tc, pair.loaded);
+            return pair.loaded->Empty() ? nullptr : pair.loaded->Pop();
+        }
+
+        void DeallocateSlow(Cache *cache, MagazinePair &pair, void *p)
+        {
+            if (pair.previous && !pair.previous->Full())
+            {
+                std::swap(pair.loaded, pair.previous);
+                pair.loaded->Push(p);
+                return;
+            }
+
+            std::lock_guard guard(cache->lock);
+            cache->counters.depot_trips.fetch_add(1, std::memory_order_relaxed);
+            Magazine *empty = TakeEmptyMagazine(cache);
+            if (!empty)
+            {
+                ReturnToSlab(cache, SlabFromPtr(p), p);
+                return;
+            }
+
+            if (pair.loaded && !pair.previous)
+            {
+                // First time past this boundary: the full one becomes
+                // previous, no depot traffic.
+                pair.previous = pair.loaded;
+            }
+            else if (pair.loaded)
+            {
+                // Both are full: the older one goes to the depot.
+                cache->full_magazines.Push(pair.previous);
+                if (cache->full_magazines.count > DepotFullLimit)
+                {
+                    Magazine *surplus = cache->full_magazines.Pop();
+                    DrainMagazine(cache, surplus);
+                    cache->empty_magazines.Push(surplus);
+                }
+                pair.previous = pair.loaded;
+            }
+
+            pair.loaded = empty;
+            pair.loaded->Push(p);
+        }
+
+        // Caller holds cache->lock.
+        static Magazine *TakeEmptyMagazine(Cache *cache)
+        {
+            if (Magazine *m = cache->empty_magazines.Pop()) { return m; }
+            return new (std::nothrow) Magazine();
+        }
+
+        // Fills the magazine from partial slabs, then empty ones, creating
+        // at most one new slab, and makes the calling thread their home.
+        // Caller holds cache->lock.
+        void RefillMagazine(Cache *cache, ThreadCache *tc, Magazine *m)
+        {
+            bool created = false;
+            while (!m->Full())
+            {
+                if (!cache->partial)
+                {
+                    if (cache->empty)
+                    {
+                        MoveSlab(cache, cache->empty, SlabList::Empty, SlabList::Partial);
+                    }
+                    else
+                    {
+                        if (created) break;
 
+                        Slab *slab = CreateSlab(cache);
+                        if (!slab) break;
+
+                        MoveSlab(cache, slab, SlabList::None, SlabList::Partial);
+                        created = true;
+                    }
+                }
+
+                Slab *slab = cache->partial;
+                slab->home.store(tc, std::memory_order_release);
+                while (!m->Full() && slab->free_slots)
+                {
+                    m->Push(PopFromSlab(slab));
+                }
+
+                if (!slab->free_slots)
+                {
+                    MoveSlab(cache, slab, SlabList::Partial, SlabList::Full);
+                }
+            }
+        }
+
+        // Caller holds cache->lock.
+        void DrainMagazine(Cache *cache, Magazine *m)
+        {
+            while (!m->Empty())
+            {
+                void *obj = m->Pop();
+                ReturnToSlab(cache, SlabFromPtr(obj), obj);
+            }
+        }
+
+        // Caller holds cache->lock.
+        void ReturnToSlab(Cache *cache, Slab *slab, void *p)
+        {
+            bool was_full = (slab->free_slots == 0);
+
+            PushToSlab(slab, p);
+
+            if (slab->free_slots == slab->total_slots)
+            {
+                MoveSlab(cache, slab, was_full ? SlabList::Full : SlabList::Partial, SlabList::Empty);
+
+                // Trim in batches, not one slab at a time, so a cache that
+                // hovers around the limit does not decommit on every free.
+                if (cache->counters.empty_slabs.load(std::memory_order_relaxed) > cache->max_partial)
+                {
+                    ReleaseEmptySlabs(cache, cache->min_partial);
+                }
+            }
+            else if (was_full)
+            {
+                MoveSlab(cache, slab, SlabList::Full, SlabList::Partial);
+            }
+        }
+
+        // Caller holds cache->lock.
+        void ReleaseEmptySlabs(Cache *cache, size_t keep)
+        {
+            while (cache->empty && cache->counters.empty_slabs.load(std::memory_order_relaxed) > keep)
+            {
+                Slab *slab = cache->empty;
+                MoveSlab(cache, slab, SlabList::Empty, SlabList::None);
+                cache->arena.RetireSlab(slab);
+
+                cache->counters.slabs_released.fetch_add(1, std::memory_order_relaxed);
+                cache->counters.bytes_committed.store(cache->arena.CommittedBytes(), std::memory_order_relaxed);
+            }
+        }
+
+        enum class SlabList
+        {
+            None,
+            Partial,
+            Full,
+            Empty
+        };
+
+        // Moves a slab between lists and keeps the counters in step. None
+        // stands for a slab entering or leaving the cache. Caller holds
+        // cache->lock.
+        static void MoveSlab(Cache *cache, Slab *slab, SlabList from, SlabList to)
+        {
+            CacheCounters &c = cache->counters;
+            auto head = [cache](SlabList list) -> Slab **
+                {
+                    switch (list)
+                    {
+                        case SlabList::Partial: return &cache->partial;
+                        case SlabList::Full:    return &cache->full;
+                        case SlabList::Empty:   return &cache->empty;
+                        default:                return nullptr;
+                    }
+                };
+            auto count = [&c](SlabList list) -> std::atomic<size_t> *
+                {
+                    switch (list)
+                    {
+                        case SlabList::Partial: return &c.partial_slabs;
+                        case SlabList::Full:    return &c.full_slabs;
+                        case SlabList::Empty:   return &c.empty_slabs;
+                        default:                return nullptr;
+                    }
+                };
+
+            if (Slab **list = head(from))
+            {
+                RemoveSlabFromList(list, slab);
+                count(from)->fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            if (Slab **list = head(to))
+            {
+                InsertSlabIntoList(list, slab);
+                count(to)->fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (from == SlabList::None) { return; }
+            switch (to)
+            {
+                case SlabList::Partial: c.to_partial.fetch_add(1, std::memory_order_relaxed); break;
+                case SlabList::Full:    c.to_full.fetch_add(1, std::memory_order_relaxed); break;
+                case SlabList::Empty:   c.to_empty.fetch_add(1, std::memory_order_relaxed); break;
+                default: break;
+            }
+        }
+
+        Slab *CreateSlab(Cache *cache)
+        {
+            size_t slab_size = cache->slab_size;
             size_t header_size = AlignUp(sizeof(Slab), sizeof(void *));
             size_t usable = slab_size - header_size;
             size_t obj_size = cache->obj_size;
             size_t slots = usable / obj_size;
             if (slots == 0)
             {
-                VirtualFree(memory, 0, MEM_RELEASE);
                 return nullptr;
             }
+
+            // Carved from the cache's reserved region: no syscall unless the
+            // committed window is used up.
+            void *memory = cache->arena.AcquireSlab();
+            if (!memory)
+            {
+                return nullptr;
+            }
+
+            cache->counters.slabs_created.fetch_add(1, std::memory_order_relaxed);
+            cache->counters.bytes_committed.store(cache->arena.CommittedBytes(), std::memory_order_relaxed);
+
+            Slab *slab = new (memory) Slab{ };
+            slab->prev = nullptr;
+            slab->next = nullptr;
+            slab->owner = cache;
             slab->total_slots = slots;
             slab->free_slots = slots;
 
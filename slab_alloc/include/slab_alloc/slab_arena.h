@@ -0,0 +1,120 @@
+#ifndef SLAB_ARENA_H
+#define SLAB_ARENA_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "slab_alloc/slab_platform.h"
+
+namespace hft
+{
+    // Slab-sized, slab-aligned blocks carved out of large reserved regions.
+    // A region is reserved once (address space only) and committed in
+    // CommitChunk steps, so most new slabs are a pointer bump with no
+    // syscall, and physical pages only arrive when a slab is first touched.
+    // Retired slabs are decommitted and kept on a cold list for reuse.
+    // Because regions are aligned to the slab size, every slab starts on a
+    // slab-size boundary and its header can be found by masking any
+    // pointer into it.
+    class SlabArena
+    {
+    public:
+        static constexpr size_t DefaultRegionBytes = size_t{ 16 } << 20;
+        static constexpr size_t CommitChunk = size_t{ 64 } << 10;
+
+        // slab_size must be a power of two and a multiple of the page size.
+        explicit SlabArena(size_t slab_size, size_t region_bytes = DefaultRegionBytes)
+            : m_slab_size(slab_size)
+            , m_region_bytes(std::max(region_bytes, slab_size) / slab_size * slab_size)
+            , m_commit_bytes(std::max(CommitChunk, slab_size) / slab_size * slab_size)
+        { }
+
+        ~SlabArena()
+        {
+            for (const Region &region : m_regions)
+            {
+                platform::Release(region.base, region.bytes);
+            }
+        }
+
+        SlabArena(const SlabArena &) = delete;
+        SlabArena &operator=(const SlabArena &) = delete;
+
+        // Returns a committed slab, or nullptr if the OS refuses more memory.
+        void *AcquireSlab()
+        {
+            if (!m_cold.empty())
+            {
+                void *slab = m_cold.back();
+                if (!platform::Recommit(slab, m_slab_size)) { return nullptr; }
+                m_cold.pop_back();
+                m_committed_bytes += m_slab_size;
+                return slab;
+            }
+
+            if (m_bump == m_committed_end && !CommitMore()) { return nullptr; }
+
+            void *slab = m_bump;
+            m_bump += m_slab_size;
+            return slab;
+        }
+
+        // Gives the slab's physical pages back; the address range is kept
+        // for the next AcquireSlab.
+        void RetireSlab(void *slab)
+        {
+            platform::Decommit(slab, m_slab_size);
+            m_committed_bytes -= m_slab_size;
+            m_cold.push_back(slab);
+        }
+
+        size_t SlabSize() const noexcept { return m_slab_size; }
+        size_t CommittedBytes() const noexcept { return m_committed_bytes; }
+        size_t ReservedBytes() const noexcept { return m_regions.size() * m_region_bytes; }
+        size_t ColdSlabs() const noexcept { return m_cold.size(); }
+
+    private:
+        struct Region
+        {
+            std::byte *base;
+            size_t bytes;
+        };
+
+        size_t m_slab_size;
+        size_t m_region_bytes;
+        size_t m_commit_bytes;
+        size_t m_committed_bytes{ 0 };
+
+        std::vector<Region> m_regions;
+        std::vector<void *> m_cold;
+        std::byte *m_bump{ nullptr };
+        std::byte *m_committed_end{ nullptr };
+        std::byte *m_region_end{ nullptr };
+
+        bool CommitMore()
+        {
+            if (m_committed_end == m_region_end)
+            {
+                void *base = platform::Reserve(m_region_bytes, m_slab_size);
+                if (!base) { return false; }
+
+                m_regions.push_back({ static_cast<std::byte *>(base), m_region_bytes });
+                m_bump = static_cast<std::byte *>(base);
+                m_committed_end = m_bump;
+                m_region_end = m_bump + m_region_bytes;
+            }
+
+            const size_t bytes = std::min(m_commit_bytes, static_cast<size_t>(m_region_end - m_committed_end));
+            if (!platform::Commit(m_committed_end, bytes)) { return false; }
+
+            m_committed_end += bytes;
+            m_committed_bytes += bytes;
+            return true;
+        }
+    };
+
+} // namespace hft
+
+#endif // SLAB_ARENA_H
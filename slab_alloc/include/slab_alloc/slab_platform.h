@@ -0,0 +1,120 @@
+#ifndef SLAB_PLATFORM_H
+#define SLAB_PLATFORM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hft::platform
+{
+    // Virtual memory primitives the slab allocator sits on.
+    //  Reserve   address space only, aligned to `alignment`
+    //  Commit    makes a reserved range usable; physical pages still
+    //            arrive on first touch
+    //  Decommit  hands the physical pages back, the range stays reserved
+    //            and reads as zero once committed again
+    //  Release   returns a whole reservation
+    //  Recommit  makes a decommitted range usable again
+    // On POSIX a decommitted range stays accessible, so Recommit is free; on
+    // Windows it is one VirtualAlloc(MEM_COMMIT).
+
+    inline size_t PageSize() noexcept
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    inline void *Reserve(size_t bytes, size_t alignment) noexcept
+    {
+#if defined(_WIN32)
+        // Reservations are 64 KiB aligned; over-reserve, then re-reserve at
+        // the aligned address inside the hole.
+        for (int attempt = 0; attempt < 8; ++attempt)
+        {
+            void *probe = VirtualAlloc(nullptr, bytes + alignment, MEM_RESERVE, PAGE_NOACCESS);
+            if (!probe) { return nullptr; }
+
+            const uintptr_t aligned = (reinterpret_cast<uintptr_t>(probe) + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+            VirtualFree(probe, 0, MEM_RELEASE);
+
+            if (void *p = VirtualAlloc(reinterpret_cast<void *>(aligned), bytes, MEM_RESERVE, PAGE_NOACCESS))
+            {
+                return p;
+            }
+        }
+        return nullptr;
+#else
+        void *raw = ::mmap(nullptr, bytes + alignment, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (raw == MAP_FAILED) { return nullptr; }
+
+        // Trim the unaligned head and the tail so exactly `bytes` remain.
+        const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (start + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+        if (aligned > start) { ::munmap(raw, aligned - start); }
+
+        const uintptr_t end = start + bytes + alignment;
+        if (end > aligned + bytes) { ::munmap(reinterpret_cast<void *>(aligned + bytes), end - (aligned + bytes)); }
+
+        return reinterpret_cast<void *>(aligned);
+#endif
+    }
+
+    inline void Release(void *base, size_t bytes) noexcept
+    {
+#if defined(_WIN32)
+        (void)bytes;
+        VirtualFree(base, 0, MEM_RELEASE);
+#else
+        ::munmap(base, bytes);
+#endif
+    }
+
+    inline bool Commit(void *p, size_t bytes) noexcept
+    {
+#if defined(_WIN32)
+        return VirtualAlloc(p, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+        return ::mprotect(p, bytes, PROT_READ | PROT_WRITE) == 0;
+#endif
+    }
+
+    inline void Decommit(void *p, size_t bytes) noexcept
+    {
+#if defined(_WIN32)
+        VirtualFree(p, bytes, MEM_DECOMMIT);
+#else
+        ::madvise(p, bytes, MADV_DONTNEED);
+#endif
+    }
+
+    inline bool Recommit(void *p, size_t bytes) noexcept
+    {
+#if defined(_WIN32)
+        return Commit(p, bytes);
+#else
+        (void)p;
+        (void)bytes;
+        return true;
+#endif
+    }
+
+} // namespace hft::platform
+
+#endif // SLAB_PLATFORM_H
@@ -0,0 +1,93 @@
+#ifndef SLAB_POOL_H
+#define SLAB_POOL_H
+
+#include <new>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "slab_alloc/slab_alloc.h"
+
+namespace hft
+{
+    // Destroys and frees an object that came from a SlabAlloc, for
+    // std::unique_ptr<T, SlabDeleter>. Any thread may run it.
+    struct SlabDeleter
+    {
+        SlabAlloc *alloc{ nullptr };
+
+        template <typename T>
+        void operator()(T *p) const noexcept
+        {
+            if (!p) { return; }
+            p->~T();
+            alloc->Deallocate(p);
+        }
+    };
+
+    template <typename T>
+    using SlabPtr = std::unique_ptr<T, SlabDeleter>;
+
+    // Typed front end over one SlabAlloc size class. The cache is resolved
+    // at construction, so Create is the magazine pop plus T's constructor.
+    // Slab objects are pointer aligned, which limits T's alignment.
+    template <typename T>
+    class SlabPool
+    {
+        static_assert(alignof(T) <= alignof(void *), "SlabAlloc objects are only pointer aligned");
+
+    public:
+        explicit SlabPool(SlabAlloc &alloc)
+            : m_alloc(&alloc)
+            , m_class(alloc.BindSizeClass(sizeof(T)))
+        {
+            if (!m_class) { throw std::length_error("SlabPool: object does not fit in a slab"); }
+        }
+
+        template <typename... Args>
+        [[nodiscard]] T *Create(Args &&...args)
+        {
+            void *memory = m_alloc->Allocate(m_class);
+            if (!memory) { throw std::bad_alloc(); }
+
+            if constexpr (std::is_nothrow_constructible_v<T, Args &&...>)
+            {
+                return ::new (memory) T(std::forward<Args>(args)...);
+            }
+            else
+            {
+                try
+                {
+                    return ::new (memory) T(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    m_alloc->Deallocate(memory);
+                    throw;
+                }
+            }
+        }
+
+        void Destroy(T *p) noexcept
+        {
+            Deleter()(p);
+        }
+
+        template <typename... Args>
+        [[nodiscard]] SlabPtr<T> MakeUnique(Args &&...args)
+        {
+            return SlabPtr<T>(Create(std::forward<Args>(args)...), Deleter());
+        }
+
+        SlabDeleter Deleter() const noexcept { return SlabDeleter{ m_alloc }; }
+        SlabAlloc &Allocator() const noexcept { return *m_alloc; }
+
+    private:
+        SlabAlloc *m_alloc;
+        SlabAlloc::SizeClass m_class;
+    };
+
+} // namespace hft
+
+#endif // SLAB_POOL_H
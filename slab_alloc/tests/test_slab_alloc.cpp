@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
+#include <vector>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <cstring>
 #include "slab_alloc/slab_alloc.h"
+#include "slab_alloc/slab_pool.h"
 
 using namespace hft;
 
@@ -107,3 +113,270 @@ TEST(SlabAllocator, ZeroAllocation)
     void *p = a.Allocate(0);
     EXPECT_EQ(p, nullptr);
 }
+
+TEST(SlabAllocator, ConcurrentAllocFree)
+{
+    SlabAlloc a;
+    constexpr int Threads = 4;
+    constexpr int Rounds = 200;
+    constexpr int Batch = 300;
+
+    std::vector<std::thread> workers;
+    std::vector<int> failures(Threads, 0);
+    for (int t = 0; t < Threads; ++t)
+    {
+        workers.emplace_back([&a, &failures, t]()
+            {
+                std::vector<uint64_t *> live;
+                live.reserve(Batch);
+                for (int round = 0; round < Rounds; ++round)
+                {
+                    for (int i = 0; i < Batch; ++i)
+                    {
+                        auto *p = static_cast<uint64_t *>(a.Allocate(sizeof(uint64_t) * (1 + i % 4)));
+                        if (!p) { ++failures[t]; continue; }
+                        *p = (static_cast<uint64_t>(t) << 32) | static_cast<uint64_t>(i);
+                        live.push_back(p);
+                    }
+
+                    // Any slot handed to two threads at once shows up here.
+                    for (size_t i = 0; i < live.size(); ++i)
+                    {
+                        if (*live[i] >> 32 != static_cast<uint64_t>(t)) { ++failures[t]; }
+                        a.Deallocate(live[i]);
+                    }
+                    live.clear();
+                }
+                a.FlushThreadCache();
+            });
+    }
+
+    // Stats are meant to be polled while the workers run.
+    std::atomic<bool> done{ false };
+    std::thread monitor([&a, &done]()
+        {
+            while (!done.load())
+            {
+                for (const SlabCacheStats &stats : a.Stats()) { EXPECT_NE(stats.object_size, 0u); }
+                std::this_thread::yield();
+            }
+        });
+
+    for (auto &w : workers) { w.join(); }
+    done.store(true);
+    monitor.join();
+    for (int t = 0; t < Threads; ++t) { EXPECT_EQ(failures[t], 0) << "thread " << t; }
+
+    // Everything went back to the slabs, so the memory is reusable.
+    void *p = a.Allocate(8);
+    ASSERT_NE(p, nullptr);
+    a.Deallocate(p);
+}
+
+TEST(SlabAllocator, MagazineBoundaryStaysOffTheDepot)
+{
+    SlabAlloc a;
+
+    // Two magazines' worth out, then one back plus one more: loaded holds
+    // a single object and previous is full.
+    std::vector<void *> held;
+    for (int i = 0; i < 129; ++i)
+    {
+        void *p = a.Allocate(32);
+        ASSERT_NE(p, nullptr);
+        held.push_back(p);
+    }
+    for (int i = 0; i < 65; ++i)
+    {
+        a.Deallocate(held.back());
+        held.pop_back();
+    }
+
+    // Allocating and freeing a few objects now crosses the boundary in
+    // both directions every round; the two magazines just swap.
+    const uint64_t trips = a.CacheStats(32).depot_trips;
+    for (int round = 0; round < 1000; ++round)
+    {
+        void *p[3];
+        for (void *&q : p) { q = a.Allocate(32); ASSERT_NE(q, nullptr); }
+        for (void *q : p) { a.Deallocate(q); }
+    }
+    EXPECT_EQ(a.CacheStats(32).depot_trips, trips);
+
+    for (void *p : held) { a.Deallocate(p); }
+}
+
+TEST(SlabAllocator, RemoteFreesReturnToHomeThread)
+{
+    SlabAlloc a;
+    // One magazine's worth: the refill leaves this thread's magazine empty,
+    // and the frees fit in the consumer's, so without the remote path they
+    // would stay cached on the freeing thread.
+    constexpr int Count = 64;
+
+    std::vector<void *> objects;
+    for (int i = 0; i < Count; ++i)
+    {
+        void *p = a.Allocate(32);
+        ASSERT_NE(p, nullptr);
+        objects.push_back(p);
+    }
+
+    std::thread consumer([&]()
+        {
+            for (void *p : objects) { a.Deallocate(p); }
+        });
+    consumer.join();
+
+    std::set<void *> freed(objects.begin(), objects.end());
+    for (int i = 0; i < Count; ++i)
+    {
+        void *p = a.Allocate(32);
+        EXPECT_EQ(freed.erase(p), 1u);
+    }
+    EXPECT_TRUE(freed.empty());
+}
+
+TEST(SlabAllocator, EmptySlabsAreReleased)
+{
+    SlabAlloc a;
+    constexpr size_t Count = 20000;
+
+    std::vector<void *> burst;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        void *p = a.Allocate(64);
+        ASSERT_NE(p, nullptr);
+        burst.push_back(p);
+    }
+
+    const SlabCacheStats peak = a.CacheStats(64);
+    EXPECT_EQ(peak.object_size, 64u);
+    EXPECT_EQ(peak.allocs, Count);
+    EXPECT_GT(peak.full_slabs, peak.max_partial);
+    EXPECT_EQ(peak.empty_slabs, 0u);
+
+    for (void *p : burst) { a.Deallocate(p); }
+
+    // Most slabs drained while freeing; the rest were held by magazines.
+    const SlabCacheStats freed = a.CacheStats(64);
+    EXPECT_EQ(freed.frees, Count);
+    EXPECT_GT(freed.slabs_released, 0u);
+    EXPECT_LE(freed.empty_slabs, freed.max_partial);
+    EXPECT_LT(freed.bytes_committed, peak.bytes_committed);
+
+    a.FlushThreadCache();
+    a.Trim();
+
+    const SlabCacheStats trimmed = a.CacheStats(64);
+    EXPECT_EQ(trimmed.full_slabs + trimmed.partial_slabs, 0u);
+    EXPECT_EQ(trimmed.empty_slabs, trimmed.min_partial);
+    EXPECT_EQ(trimmed.slabs_released, trimmed.slabs_created - trimmed.min_partial);
+    EXPECT_GE(trimmed.to_empty, trimmed.slabs_created);
+
+    // The kept slabs serve the next burst without new ones.
+    void *p = a.Allocate(64);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(a.CacheStats(64).slabs_created, trimmed.slabs_created);
+    a.Deallocate(p);
+}
+
+namespace
+{
+    struct Tracked
+    {
+        static inline int live = 0;
+
+        explicit Tracked(int v) : value(v) { ++live; }
+        ~Tracked() { --live; }
+
+        int value;
+    };
+
+    struct ThrowsOnConstruct
+    {
+        ThrowsOnConstruct() { throw std::runtime_error("boom"); }
+    };
+}
+
+TEST(SlabPool, CreateDestroyAndUniquePtr)
+{
+    SlabAlloc a;
+    SlabPool<Tracked> pool(a);
+
+    Tracked *t = pool.Create(7);
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(t->value, 7);
+    EXPECT_EQ(Tracked::live, 1);
+
+    pool.Destroy(t);
+    EXPECT_EQ(Tracked::live, 0);
+
+    {
+        SlabPtr<Tracked> owned = pool.MakeUnique(9);
+        EXPECT_EQ(owned->value, 9);
+        EXPECT_EQ(Tracked::live, 1);
+
+        // Same slot as the object destroyed above: the pool shares the
+        // allocator's caches.
+        EXPECT_EQ(static_cast<void *>(owned.get()), static_cast<void *>(t));
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(SlabPool, ConstructorExceptionReturnsMemory)
+{
+    SlabAlloc a;
+    SlabPool<ThrowsOnConstruct> pool(a);
+
+    void *slot = a.Allocate(sizeof(ThrowsOnConstruct));
+    ASSERT_NE(slot, nullptr);
+    a.Deallocate(slot);
+
+    // The failed construction takes that slot and must hand it back.
+    EXPECT_THROW((void)pool.Create(), std::runtime_error);
+    void *again = a.Allocate(sizeof(ThrowsOnConstruct));
+    EXPECT_EQ(again, slot);
+    a.Deallocate(again);
+}
+
+TEST(SlabArena, SlabsAreAlignedAndReusedAfterRetire)
+{
+    SlabArena arena(4096, size_t{ 1 } << 20);
+
+    void *first = arena.AcquireSlab();
+    void *second = arena.AcquireSlab();
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % 4096, 0u);
+    EXPECT_EQ(static_cast<std::byte *>(second) - static_cast<std::byte *>(first), 4096);
+    EXPECT_EQ(arena.ReservedBytes(), size_t{ 1 } << 20);
+    EXPECT_EQ(arena.CommittedBytes(), SlabArena::CommitChunk);
+
+    std::memset(first, 0xAB, 4096);
+    arena.RetireSlab(first);
+    EXPECT_EQ(arena.ColdSlabs(), 1u);
+    EXPECT_EQ(arena.CommittedBytes(), SlabArena::CommitChunk - 4096);
+
+    // A retired slab comes back first, with its old contents gone.
+    void *again = arena.AcquireSlab();
+    EXPECT_EQ(again, first);
+    EXPECT_EQ(static_cast<unsigned char *>(again)[100], 0u);
+}
+
+TEST(SlabArena, GrowsIntoNewRegions)
+{
+    SlabArena arena(4096, size_t{ 64 } << 10);
+
+    std::vector<void *> slabs;
+    for (int i = 0; i < 40; ++i)
+    {
+        void *slab = arena.AcquireSlab();
+        ASSERT_NE(slab, nullptr);
+        std::memset(slab, i, 4096);
+        slabs.push_back(slab);
+    }
+
+    EXPECT_EQ(arena.ReservedBytes(), 3 * (size_t{ 64 } << 10));
+    for (void *slab : slabs) { EXPECT_EQ(reinterpret_cast<uintptr_t>(slab) % 4096, 0u); }
+}
@@ -7,8 +7,19 @@
 #include <fstream>
 #include <chrono>
 #include <format>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <span>
+#include <cstring>
+#include <cstddef>
 
 #include "ring_buffer/ring_buffer.h"
+#include "ring_buffer/byte_ring_buffer.h"
+#include "ring_buffer/broadcast_ring_buffer.h"
+#include "ring_buffer/wait_strategy.h"
+#include "ring_buffer/huge_page_allocator.h"
 #include "order_generator/order_generator.h"
 #include "order_parser/message_parser.h"
 #include "matching_engine/matching_engine.h"
@@ -17,37 +28,136 @@
 
 namespace hft
 {
+    // Startup layout of the pipeline. Symbols are spread over shard_count
+    // engine threads; symbol_shards[i] pins symbols[i] to a shard, and when it
+    // is left empty symbols are dealt round-robin. Each stage idles with its
+    // own wait strategy, both on an empty input and on a full output;
+    // SpinPark stages are woken by their producer. The agent only ever
+    // backs off on a full ring, which nobody signals, so SpinPark there
+    // stops at yielding.
+    struct PipelineConfig
+    {
+        std::vector<SymbolReference> symbols{ SymbolReference{ 1, 16384, 2048 } };
+        size_t shard_count{ 1 };
+        std::vector<uint32_t> symbol_shards;
+
+        WaitConfig agent_wait{ };
+        WaitConfig parser_wait{ };
+        WaitConfig engine_wait{ };
+        WaitConfig logger_wait{ };
+    };
+
     class TradingPipeline
     {
     private:
         static constexpr size_t RING_BUFFER_SIZE = 1024;
-
-        SPSCRingBuffer<std::vector<uint8_t>, RING_BUFFER_SIZE> m_agent_to_parser;
-        SPSCRingBuffer<OrderRequest, RING_BUFFER_SIZE> m_parser_to_engine;
-        SPSCRingBuffer<TradeEvent, RING_BUFFER_SIZE> m_engine_to_logger;
-
-        OrderGenerator m_generator;
+        static constexpr size_t BATCH_SIZE = 64;
+        static constexpr size_t AGENT_RING_BYTES = 64 * 1024;
+        static constexpr uint32_t InvalidShard = std::numeric_limits<uint32_t>::max();
+
+        using TradeRing = BroadcastRingBuffer<TradeEvent, RING_BUFFER_SIZE>;
+
+        // One engine thread with its own books and its own rings on either
+        // side, so shards share nothing on the hot path. The request ring is
+        // prefaulted at startup. Fills are pushed straight into the output
+        // ring by the engine's sink; the output ring is a broadcast ring, so
+        // further readers (market data, risk, drop-copy) attach with
+        // trades.AddConsumer() instead of more copies.
+        struct EngineShard
+        {
+            EngineShard(std::span<const SymbolReference> symbols, const std::atomic<bool> &running,
+                        WaitSignal &logger_wakeup, const WaitConfig &logger_wait)
+                : engine(symbols, RingTradeSink<TradeRing>(trades, &running, &logger_wakeup, logger_wait))
+            { }
+
+            SPSCRingBuffer<OrderRequest, RING_BUFFER_SIZE, HugePageAllocator<OrderRequest>> requests;
+            TradeRing trades;
+            TradeRing::Consumer &trade_log{ trades.AddConsumer() };
+            MatchingEngine<LadderOrderbook, RingTradeSink<TradeRing>> engine;
+            std::thread thread;
+            WaitSignal wakeup;
+
+            alignas(64) std::atomic<uint64_t> orders_matched{ 0 };
+            std::atomic<uint64_t> trades_emitted{ 0 };
+        };
+
+        // Wire messages differ in size, so they travel as variable-length
+        // records rather than one heap buffer per message.
+        ByteRingBuffer<AGENT_RING_BYTES> m_agent_to_parser;
+
+        std::vector<OrderGenerator> m_generators;
         MessageParser m_parser;
-        MatchingEngine m_engine;
+        std::vector<std::unique_ptr<EngineShard>> m_shards;
+        std::vector<uint32_t> m_shard_of_symbol;
         Logger m_logger;
 
         std::thread m_agent_thread;
         std::thread m_parser_thread;
-        std::thread m_engine_thread;
         std::thread m_logger_thread;
 
         std::atomic<bool> m_running{ false };
         std::atomic<uint64_t> m_orders_generated{ 0 };
         std::atomic<uint64_t> m_orders_parsed{ 0 };
-        std::atomic<uint64_t> m_orders_matched{ 0 };
+        std::atomic<uint64_t> m_orders_unroutable{ 0 };
         std::atomic<uint64_t> m_trades_logged{ 0 };
 
+        WaitConfig m_agent_wait;
+        WaitConfig m_parser_wait;
+        WaitConfig m_engine_wait;
+        WaitConfig m_logger_wait;
+        WaitSignal m_parser_wakeup;
+        WaitSignal m_logger_wakeup;
+
 
     public:
-        TradingPipeline(uint32_t symbol_id = 1)
-            : m_generator(symbol_id)
-            , m_logger("trades.log")
+        explicit TradingPipeline(const PipelineConfig &config = { })
+            : m_logger("trades.log")
+            , m_agent_wait(config.agent_wait)
+            , m_parser_wait(config.parser_wait)
+            , m_engine_wait(config.engine_wait)
+            , m_logger_wait(config.logger_wait)
         { 
+            if (config.symbols.empty() || config.shard_count == 0)
+            {
+                throw std::invalid_argument("Pipeline needs at least one symbol and one shard");
+            }
+            if (!config.symbol_shards.empty() && config.symbol_shards.size() != config.symbols.size())
+            {
+                throw std::invalid_argument("symbol_shards must map every symbol");
+            }
+
+            std::vector<std::vector<SymbolReference>> shard_symbols(config.shard_count);
+            uint32_t max_id = 0;
+            for (size_t i = 0; i < config.symbols.size(); ++i)
+            {
+                const size_t shard = config.symbol_shards.empty() ? i % config.shard_count : config.symbol_shards[i];
+                if (shard >= config.shard_count)
+                {
+                    throw std::invalid_argument("Symbol mapped to a shard that does not exist");
+                }
+
+                shard_symbols[shard].push_back(config.symbols[i]);
+                max_id = std::max(max_id, config.symbols[i].symbol_id);
+            }
+
+            m_shard_of_symbol.assign(size_t{ max_id } + 1, InvalidShard);
+            m_shards.reserve(config.shard_count);
+            for (size_t shard = 0; shard < config.shard_count; ++shard)
+            {
+                for (const auto &ref : shard_symbols[shard])
+                {
+                    m_shard_of_symbol[ref.symbol_id] = static_cast<uint32_t>(shard);
+                }
+                m_shards.push_back(std::make_unique<EngineShard>(shard_symbols[shard], m_running,
+                                                                 m_logger_wakeup, m_logger_wait));
+            }
+
+            m_generators.reserve(config.symbols.size());
+            for (const auto &ref : config.symbols)
+            {
+                m_generators.emplace_back(ref.symbol_id);
+            }
+
             m_logger.Log(LogLevel::INFO, "timestamp_ns, maker_id, taker_id, price, quantity");
         }
 
@@ -69,11 +179,15 @@ namespace hft
             std::cout << "Starting trading pipeline...\n";
 
             m_logger_thread = std::thread(&TradingPipeline::LoggerThread, this);
-            m_engine_thread = std::thread(&TradingPipeline::EngineThread, this);
+            for (auto &shard : m_shards)
+            {
+                shard->thread = std::thread(&TradingPipeline::EngineThread, this, std::ref(*shard));
+            }
             m_parser_thread = std::thread(&TradingPipeline::ParserThread, this);
             m_agent_thread = std::thread(&TradingPipeline::AgentThread, this);
 
-            std::cout << "Pipeline started with 4 threads\n";
+            std::cout << "Pipeline started with " << m_shards.size() + 3 << " threads ("
+                      << m_shards.size() << " engine shards)\n";
         }
 
         void Stop()
@@ -83,11 +197,20 @@ namespace hft
 
             std::cout << "Stopping trading pipeline...\n";
 
+            // Parked stages only wake on a signal, so give each one a kick
+            // to notice m_running has dropped.
+            m_parser_wakeup.Notify();
+            m_logger_wakeup.Notify();
+            for (auto &shard : m_shards) { shard->wakeup.Notify(); }
+
             if (m_agent_thread.joinable()) { m_agent_thread.join(); }
             
             if (m_parser_thread.joinable()) { m_parser_thread.join(); }
             
-            if (m_engine_thread.joinable()) { m_engine_thread.join(); }
+            for (auto &shard : m_shards)
+            {
+                if (shard->thread.joinable()) { shard->thread.join(); }
+            }
             
             if (m_logger_thread.joinable()) { m_logger_thread.join(); }
 
@@ -98,15 +221,30 @@ namespace hft
 
         void PrintStats() const
         {
+            uint64_t orders_matched = 0;
+            for (const auto &shard : m_shards) { orders_matched += shard->orders_matched.load(); }
+
             std::cout << "\n=== Pipeline Statistics ===\n";
             std::cout << "Orders Generated: " << m_orders_generated.load() << "\n";
             std::cout << "Orders Parsed: " << m_orders_parsed.load() << "\n";
-            std::cout << "Orders Matched: " << m_orders_matched.load() << "\n";
+            std::cout << "Orders Unroutable: " << m_orders_unroutable.load() << "\n";
+            std::cout << "Orders Matched: " << orders_matched << "\n";
             std::cout << "Trades Logged: " << m_trades_logged.load() << "\n";
+            std::cout << "\n=== Shard Statistics ===\n";
+            for (size_t i = 0; i < m_shards.size(); ++i)
+            {
+                const auto &shard = *m_shards[i];
+                std::cout << "Shard " << i << ": matched " << shard.orders_matched.load()
+                          << ", trades " << shard.trades_emitted.load()
+                          << ", unknown symbol " << shard.engine.UnknownSymbolCount() << "\n";
+            }
             std::cout << "\n=== Buffer Status ===\n";
-            std::cout << "Agent->Parser: " << m_agent_to_parser.Size() << "\n";
-            std::cout << "Parser->Engine: " << m_parser_to_engine.Size() << "\n";
-            std::cout << "Engine->Logger: " << m_engine_to_logger.Size() << "\n";
+            std::cout << "Agent->Parser: " << m_agent_to_parser.Size() << " bytes\n";
+            for (size_t i = 0; i < m_shards.size(); ++i)
+            {
+                std::cout << "Parser->Engine[" << i << "]: " << m_shards[i]->requests.Size() << "\n";
+                std::cout << "Engine[" << i << "]->Logger: " << m_shards[i]->trades.Size() << "\n";
+            }
             std::cout << "========================\n";
         }
 
@@ -115,11 +253,16 @@ namespace hft
         {
             std::cout << "Agent thread started\n";
 
+            size_t next_generator = 0;
+
             while (m_running.load())
             {
-                auto request = m_generator.GenerateNext();
+                OrderGenerator &generator = m_generators[next_generator];
+                if (++next_generator == m_generators.size()) { next_generator = 0; }
+
+                auto request = generator.GenerateNext();
 
-                std::vector<uint8_t> buffer;
+                bool published = false;
 
                 if (request.type == RequestType::NEW_ORDER)
                 {
@@ -129,13 +272,13 @@ namespace hft
                     msg.header.version = 1;
                     msg.order_id = request.order.id;
                     msg.symbol_id = request.order.symbol_id;
-                    msg.price_ticks = static_cast<uint32_t>(request.order.price / 0.01);
+                    msg.price_ticks = static_cast<uint32_t>(request.order.price.value);
                     msg.quantity = request.order.quantity;
                     msg.side = (request.order.side == Side::BUY) ?
                         protocol::Side::BUY : protocol::Side::SELL;
                     msg.tif = ConvertTif(request.order.tif);
 
-                    buffer = protocol::BinaryCodec::Encode(msg);
+                    published = Publish(msg);
                 }
                 else if (request.type == RequestType::CANCEL_ORDER)
                 {
@@ -146,90 +289,136 @@ namespace hft
                     msg.order_id = request.order_id_to_cancel;
                     msg.symbol_id = request.symbol_id;
 
-                    buffer = protocol::BinaryCodec::Encode(msg);
+                    published = Publish(msg);
                 }
-
-                while (!m_agent_to_parser.TryPush(buffer))
+                else if (request.type == RequestType::MODIFY_ORDER)
                 {
-                    if (!m_running.load())
-                        return;
-                    std::this_thread::yield();
+                    protocol::ModifyOrderMessage msg{};
+                    msg.header.msg_type = protocol::MessageType::MODIFY_ORDER;
+                    msg.header.msg_length = sizeof(msg);
+                    msg.header.version = 1;
+                    msg.order_id = request.order.id;
+                    msg.symbol_id = request.symbol_id;
+                    msg.new_price_ticks = static_cast<uint32_t>(request.order.price.value);
+                    msg.new_quantity = request.order.quantity;
+
+                    published = Publish(msg);
                 }
 
+                if (!published)
+                    return;
+
                 m_orders_generated.fetch_add(1);
 
-                auto sleep_us = m_generator.GetNextArrivalTime();
+                auto sleep_us = generator.GetNextArrivalTime();
                 std::this_thread::sleep_for(std::chrono::microseconds(sleep_us));
             }
 
             std::cout << "Agent thread stopped\n";
         }
 
+        // Encodes a wire message straight into a claimed record of the
+        // agent->parser ring; gives up only when the pipeline stops.
+        template <typename Message>
+        bool Publish(const Message &msg)
+        {
+            std::span<std::byte> dst;
+            IdleWaiter backoff(m_agent_wait);
+            while ((dst = m_agent_to_parser.TryClaim(sizeof(msg))).empty())
+            {
+                if (!m_running.load())
+                    return false;
+                backoff.Idle();
+            }
+
+            std::memcpy(dst.data(), &msg, sizeof(msg));
+            m_agent_to_parser.Commit();
+            Wake(m_parser_wait, m_parser_wakeup);
+            return true;
+        }
+
         void ParserThread()
         {
             std::cout << "Parser thread started\n";
 
+            // Requests are staged per shard and handed over with one
+            // TryPushN each, so a burst costs one index publish per shard.
+            std::vector<std::vector<OrderRequest>> staged(m_shards.size());
+            for (auto &batch : staged) { batch.reserve(BATCH_SIZE); }
 
+            IdleWaiter waiter(m_parser_wait, &m_parser_wakeup);
             while (m_running.load())
             {
-                auto buffer = m_agent_to_parser.Peek();
-                if (buffer)
+                size_t popped = m_agent_to_parser.ConsumeN([this, &staged](std::span<const std::byte> record)
+                    {
+                        OrderRequest request = m_parser.ParseMessage(record);
+
+                        const uint32_t shard = ShardIndexFor(request.symbol_id);
+                        if (shard == InvalidShard)
+                        {
+                            m_orders_unroutable.fetch_add(1, std::memory_order_relaxed);
+                            return;
+                        }
+                        staged[shard].push_back(request);
+                    }, BATCH_SIZE);
+
+                if (popped == 0)
                 {
-                    OrderRequest request = m_parser.ParseMessage(*buffer);
-                    m_agent_to_parser.TryPop();
+                    waiter.Idle();
+                    continue;
+                }
+                waiter.Reset();
 
-                    while (!m_parser_to_engine.TryPush(request))
+                for (size_t i = 0; i < staged.size(); ++i)
+                {
+                    std::span<const OrderRequest> pending = staged[i];
+                    IdleWaiter backoff(m_parser_wait);
+                    while (!pending.empty())
                     {
+                        const size_t pushed = m_shards[i]->requests.TryPushN(pending);
+                        if (pushed > 0) { Wake(m_engine_wait, m_shards[i]->wakeup); }
+                        pending = pending.subspan(pushed);
+                        if (pending.empty()) { break; }
                         if (!m_running.load())
                             return;
-                        std::this_thread::yield();
+                        backoff.Idle();
                     }
 
-                    m_orders_parsed.fetch_add(1);
-                }
-                else
-                {
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
+                    m_orders_parsed.fetch_add(staged[i].size());
+                    staged[i].clear();
                 }
             }
 
             std::cout << "Parser thread stopped\n";
         }
 
-        void EngineThread()
+        void EngineThread(EngineShard &shard)
         {
-            std::cout << "Engine thread started\n";
-
-
+            IdleWaiter waiter(m_engine_wait, &shard.wakeup);
             while (m_running.load())
             {
-                auto request = m_parser_to_engine.Peek();
-                if (request)
-                {
-                    m_engine.ProcessOrderRequest(*request);
-                    m_parser_to_engine.TryPop();
-
-                    auto trades = m_engine.GetAndClearTrades();
-
-                    for (const auto &trade : trades)
+                size_t processed = shard.requests.PopN([&shard](OrderRequest &request)
                     {
-                        while (!m_engine_to_logger.TryPush(trade))
-                        {
-                            if (!m_running.load())
-                                return;
-                            std::this_thread::yield();
-                        }
-                    }
+                        shard.engine.ProcessOrderRequest(request);
+                    }, BATCH_SIZE);
 
-                    m_orders_matched.fetch_add(1);
+                if (processed == 0)
+                {
+                    waiter.Idle();
+                    continue;
                 }
-                else
+                waiter.Reset();
+
+                // Only this thread writes the shard counters; relaxed is
+                // enough for PrintStats and keeps them off the fence path.
+                const uint64_t emitted = shard.engine.GetSink().Emitted();
+                if (emitted != shard.trades_emitted.load(std::memory_order_relaxed))
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
+                    Wake(m_logger_wait, m_logger_wakeup);
                 }
+                shard.orders_matched.fetch_add(processed, std::memory_order_relaxed);
+                shard.trades_emitted.store(emitted, std::memory_order_relaxed);
             }
-
-            std::cout << "Engine thread stopped\n";
         }
 
         void LoggerThread()
@@ -238,40 +427,54 @@ namespace hft
 
             size_t batch_count = 0;
 
+            IdleWaiter waiter(m_logger_wait, &m_logger_wakeup);
             while (m_running.load())
             {
-                auto trade = m_engine_to_logger.Peek();
-                if (trade)
+                // Round-robin over the shard outputs, draining at most one
+                // ring's worth per visit so a hot shard cannot starve the rest.
+                bool drained_any = false;
+                for (auto &shard : m_shards)
                 {
-                    std::string trade_msg = std::format("{},{},{},{},{}",
-                                                        trade->timestamp_ns,
-                                                        trade->maker_order_id,
-                                                        trade->taker_order_id,
-                                                        trade->price,
-                                                        trade->quantity);
-                    
-                    m_engine_to_logger.TryPop();
-                    m_logger.Log(LogLevel::INFO, trade_msg);
-
-                    m_trades_logged.fetch_add(1);
-                    batch_count++;
-
-                    if (batch_count >= 100)
-                    {
-                        m_logger.Flush();
-                        batch_count = 0;
-                    }
+                    size_t drained = shard->trade_log.PopN([this, &batch_count](const TradeEvent &trade)
+                        {
+                            std::string trade_msg = std::format("{},{},{},{},{}",
+                                                                trade.timestamp_ns,
+                                                                trade.maker_order_id,
+                                                                trade.taker_order_id,
+                                                                ToDecimal(trade.price),
+                                                                trade.quantity);
+
+                            m_logger.Log(LogLevel::INFO, trade_msg);
+
+                            if (++batch_count >= 100)
+                            {
+                                m_logger.Flush();
+                                batch_count = 0;
+                            }
+                        }, RING_BUFFER_SIZE);
+
+                    m_trades_logged.fetch_add(drained);
+                    drained_any = drained_any || drained > 0;
                 }
-                else
+
+                if (!drained_any)
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds(10));
+                    waiter.Idle();
+                    continue;
                 }
+                waiter.Reset();
             }
 
             m_logger.Flush();
             std::cout << "Logger thread stopped\n";
         }
 
+        uint32_t ShardIndexFor(uint32_t symbol_id) const noexcept
+        {
+            if (symbol_id >= m_shard_of_symbol.size()) { return InvalidShard; }
+            return m_shard_of_symbol[symbol_id];
+        }
+
         static protocol::TimeInForce ConvertTif(TimeInForce tif)
         {
             switch (tif)
@@ -286,4 +489,4 @@ namespace hft
 
 } // namespace hft
 
-#endif // TRADING_PIPELINE_H
\ No newline at end of file
+#endif // TRADING_PIPELINE_H
@@ -2,7 +2,17 @@
 
 int main()
 {
-    hft::TradingPipeline pipeline(1);
+    hft::PipelineConfig config;
+    config.symbols = {
+        hft::SymbolReference{ 1, 16384, 2048 },
+        hft::SymbolReference{ 2, 16384, 2048 },
+        hft::SymbolReference{ 3, 4096, 1024 },
+        hft::SymbolReference{ 4, 4096, 1024 },
+    };
+    config.shard_count = 2;
+    config.engine_wait.mode = hft::WaitMode::SpinPark;
+
+    hft::TradingPipeline pipeline(config);
 
     pipeline.Start();
 